@@ -0,0 +1,46 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "channel.h"
+
+namespace {
+
+constexpr size_t items = 4000000;
+constexpr size_t capacity = 1024;
+
+double run(size_t batch) {
+  containers::channel<size_t> ch(capacity);
+  auto start = std::chrono::steady_clock::now();
+
+  std::thread producer([&ch, batch] {
+    std::vector<size_t> chunk(batch);
+    for (size_t sent = 0; sent < items; sent += batch) {
+      for (size_t i = 0; i < batch; ++i) chunk[i] = sent + i;
+      ch.push_batch(chunk.begin(), chunk.end());
+    }
+    ch.close();
+  });
+
+  std::vector<size_t> out(batch);
+  size_t received = 0;
+  while (size_t n = ch.pop_batch(out.begin(), batch)) {
+    received += n;
+  }
+  producer.join();
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return static_cast<double>(received) / elapsed.count();
+}
+
+}
+
+int main() {
+  std::printf("%8s %16s\n", "batch", "items/sec");
+  for (size_t batch : {1, 4, 16, 64, 256}) {
+    std::printf("%8zu %16.0f\n", batch, run(batch));
+  }
+  return 0;
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "circular_buffer_iterator.h"
+
+namespace containers {
+
+template <typename T>
+class circular_buffer {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using size_type = size_t;
+  using iterator = circular_buffer_iterator<T>;
+  using const_iterator = circular_buffer_iterator<const T>;
+  using array_range = std::pair<pointer, size_type>;
+  using const_array_range = std::pair<const_pointer, size_type>;
+
+  circular_buffer() = default;
+  explicit circular_buffer(size_type capacity);
+  circular_buffer(size_type capacity, std::initializer_list<T> const& items);
+  circular_buffer(const circular_buffer& other);
+  circular_buffer(circular_buffer&& other) noexcept;
+  ~circular_buffer() = default;
+
+  circular_buffer& operator=(const circular_buffer& other);
+  circular_buffer& operator=(circular_buffer&& other) noexcept;
+
+  reference operator[](size_type pos) noexcept;
+  const_reference operator[](size_type pos) const noexcept;
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  reference front();
+  const_reference front() const;
+  reference back();
+  const_reference back() const;
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  bool full() const noexcept;
+  size_type size() const noexcept;
+  size_type capacity() const noexcept;
+  size_type reserve() const noexcept;
+
+  array_range array_one() noexcept;
+  array_range array_two() noexcept;
+  const_array_range array_one() const noexcept;
+  const_array_range array_two() const noexcept;
+
+  void push_back(const_reference value);
+  void push_back(T&& value);
+  void push_front(const_reference value);
+  void pop_front();
+  void pop_back();
+  void clear();
+  void swap(circular_buffer& other) noexcept;
+
+ protected:
+  void allocate_buffer(size_type capacity);
+
+ private:
+  size_type physical(size_type pos) const noexcept {
+    size_type index = head_ + pos;
+    return index < capacity_ ? index : index - capacity_;
+  }
+  void increment(size_type& index) const noexcept {
+    if (++index == capacity_) index = 0;
+  }
+  void decrement(size_type& index) const noexcept {
+    index = (index == 0 ? capacity_ : index) - 1;
+  }
+
+  std::unique_ptr<T[]> data_;
+  size_type capacity_{0};
+  size_type head_{0};
+  size_type size_{0};
+};
+
+template <typename T>
+void circular_buffer<T>::allocate_buffer(size_type capacity) {
+  try {
+    data_.reset(new T[capacity]);
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+}
+
+template <typename T>
+circular_buffer<T>::circular_buffer(size_type capacity) : capacity_(capacity) {
+  if (capacity_) {
+    allocate_buffer(capacity_);
+  }
+}
+
+template <typename T>
+circular_buffer<T>::circular_buffer(size_type capacity,
+                                    std::initializer_list<T> const& items)
+    : circular_buffer(capacity) {
+  for (auto& el : items) {
+    push_back(el);
+  }
+}
+
+template <typename T>
+circular_buffer<T>::circular_buffer(const circular_buffer& other)
+    : circular_buffer(other.capacity_) {
+  std::copy(other.begin(), other.end(), data_.get());
+  size_ = other.size_;
+}
+
+template <typename T>
+circular_buffer<T>::circular_buffer(circular_buffer&& other) noexcept
+    : data_(std::move(other.data_)),
+      capacity_(other.capacity_),
+      head_(other.head_),
+      size_(other.size_) {
+  other.capacity_ = other.head_ = other.size_ = 0;
+}
+
+template <typename T>
+circular_buffer<T>& circular_buffer<T>::operator=(
+    const circular_buffer& other) {
+  if (this != &other) {
+    circular_buffer tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T>
+circular_buffer<T>& circular_buffer<T>::operator=(
+    circular_buffer&& other) noexcept {
+  if (this != &other) {
+    circular_buffer tmp{std::move(other)};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T>
+typename circular_buffer<T>::reference circular_buffer<T>::operator[](
+    size_type pos) noexcept {
+  return data_[physical(pos)];
+}
+
+template <typename T>
+typename circular_buffer<T>::const_reference circular_buffer<T>::operator[](
+    size_type pos) const noexcept {
+  return data_[physical(pos)];
+}
+
+template <typename T>
+typename circular_buffer<T>::reference circular_buffer<T>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Error: Attempt to access beyond the buffer");
+  }
+  return (*this)[pos];
+}
+
+template <typename T>
+typename circular_buffer<T>::const_reference circular_buffer<T>::at(
+    size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("Error: Attempt to access beyond the buffer");
+  }
+  return (*this)[pos];
+}
+
+template <typename T>
+typename circular_buffer<T>::reference circular_buffer<T>::front() {
+  return at(0);
+}
+
+template <typename T>
+typename circular_buffer<T>::const_reference circular_buffer<T>::front()
+    const {
+  return at(0);
+}
+
+template <typename T>
+typename circular_buffer<T>::reference circular_buffer<T>::back() {
+  return at(size_ - 1);
+}
+
+template <typename T>
+typename circular_buffer<T>::const_reference circular_buffer<T>::back() const {
+  return at(size_ - 1);
+}
+
+template <typename T>
+typename circular_buffer<T>::iterator circular_buffer<T>::begin() noexcept {
+  return iterator(data_.get(), capacity_, head_, 0);
+}
+
+template <typename T>
+typename circular_buffer<T>::iterator circular_buffer<T>::end() noexcept {
+  return iterator(data_.get(), capacity_, head_, size_);
+}
+
+template <typename T>
+typename circular_buffer<T>::const_iterator circular_buffer<T>::begin()
+    const noexcept {
+  return const_iterator(data_.get(), capacity_, head_, 0);
+}
+
+template <typename T>
+typename circular_buffer<T>::const_iterator circular_buffer<T>::end()
+    const noexcept {
+  return const_iterator(data_.get(), capacity_, head_, size_);
+}
+
+template <typename T>
+typename circular_buffer<T>::const_iterator circular_buffer<T>::cbegin()
+    const noexcept {
+  return begin();
+}
+
+template <typename T>
+typename circular_buffer<T>::const_iterator circular_buffer<T>::cend()
+    const noexcept {
+  return end();
+}
+
+template <typename T>
+bool circular_buffer<T>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename T>
+bool circular_buffer<T>::full() const noexcept {
+  return size_ == capacity_;
+}
+
+template <typename T>
+typename circular_buffer<T>::size_type circular_buffer<T>::size()
+    const noexcept {
+  return size_;
+}
+
+template <typename T>
+typename circular_buffer<T>::size_type circular_buffer<T>::capacity()
+    const noexcept {
+  return capacity_;
+}
+
+template <typename T>
+typename circular_buffer<T>::size_type circular_buffer<T>::reserve()
+    const noexcept {
+  return capacity_ - size_;
+}
+
+template <typename T>
+typename circular_buffer<T>::array_range
+circular_buffer<T>::array_one() noexcept {
+  return {data_.get() + head_, std::min(size_, capacity_ - head_)};
+}
+
+template <typename T>
+typename circular_buffer<T>::array_range
+circular_buffer<T>::array_two() noexcept {
+  size_type first = std::min(size_, capacity_ - head_);
+  return {data_.get(), size_ - first};
+}
+
+template <typename T>
+typename circular_buffer<T>::const_array_range circular_buffer<T>::array_one()
+    const noexcept {
+  return {data_.get() + head_, std::min(size_, capacity_ - head_)};
+}
+
+template <typename T>
+typename circular_buffer<T>::const_array_range circular_buffer<T>::array_two()
+    const noexcept {
+  size_type first = std::min(size_, capacity_ - head_);
+  return {data_.get(), size_ - first};
+}
+
+template <typename T>
+void circular_buffer<T>::push_back(const_reference value) {
+  if (!capacity_) return;
+
+  if (full()) {
+    data_[head_] = value;
+    increment(head_);
+  } else {
+    data_[physical(size_)] = value;
+    ++size_;
+  }
+}
+
+template <typename T>
+void circular_buffer<T>::push_back(T&& value) {
+  if (!capacity_) return;
+
+  if (full()) {
+    data_[head_] = std::move(value);
+    increment(head_);
+  } else {
+    data_[physical(size_)] = std::move(value);
+    ++size_;
+  }
+}
+
+template <typename T>
+void circular_buffer<T>::push_front(const_reference value) {
+  if (!capacity_) return;
+
+  decrement(head_);
+  data_[head_] = value;
+  if (!full()) {
+    ++size_;
+  }
+}
+
+template <typename T>
+void circular_buffer<T>::pop_front() {
+  if (empty()) {
+    throw std::runtime_error("Error: Buffer is empty");
+  }
+  data_[head_] = T{};
+  increment(head_);
+  --size_;
+}
+
+template <typename T>
+void circular_buffer<T>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error("Error: Buffer is empty");
+  }
+  data_[physical(size_ - 1)] = T{};
+  --size_;
+}
+
+template <typename T>
+void circular_buffer<T>::clear() {
+  for (size_type i = 0; i < size_; ++i) {
+    data_[physical(i)] = T{};
+  }
+  head_ = size_ = 0;
+}
+
+template <typename T>
+void circular_buffer<T>::swap(circular_buffer& other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(head_, other.head_);
+  std::swap(size_, other.size_);
+}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace containers {
+
+template <typename T>
+class circular_buffer_iterator {
+ public:
+  using value_type = std::remove_const_t<T>;
+  using pointer = T*;
+  using reference = T&;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::random_access_iterator_tag;
+  using size_type = size_t;
+
+  circular_buffer_iterator() = default;
+  circular_buffer_iterator(pointer data, size_type capacity, size_type head,
+                           size_type index) noexcept
+      : data_(data), capacity_(capacity), head_(head), index_(index) {}
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T> &&
+                                        !std::is_same_v<U, T>>>
+  circular_buffer_iterator(const circular_buffer_iterator<U>& other) noexcept
+      : data_(other.data_),
+        capacity_(other.capacity_),
+        head_(other.head_),
+        index_(other.index_) {}
+
+  reference operator*() const noexcept { return data_[physical(index_)]; }
+  pointer operator->() const noexcept { return data_ + physical(index_); }
+  reference operator[](difference_type n) const noexcept {
+    return data_[physical(index_ + n)];
+  }
+
+  circular_buffer_iterator& operator++() noexcept {
+    ++index_;
+    return *this;
+  }
+  circular_buffer_iterator operator++(int) noexcept {
+    auto tmp{*this};
+    ++index_;
+    return tmp;
+  }
+  circular_buffer_iterator& operator--() noexcept {
+    --index_;
+    return *this;
+  }
+  circular_buffer_iterator operator--(int) noexcept {
+    auto tmp{*this};
+    --index_;
+    return tmp;
+  }
+
+  circular_buffer_iterator& operator+=(difference_type step) noexcept {
+    index_ += step;
+    return *this;
+  }
+  circular_buffer_iterator& operator-=(difference_type step) noexcept {
+    index_ -= step;
+    return *this;
+  }
+  circular_buffer_iterator operator+(difference_type step) const noexcept {
+    auto tmp{*this};
+    return tmp += step;
+  }
+  circular_buffer_iterator operator-(difference_type step) const noexcept {
+    auto tmp{*this};
+    return tmp -= step;
+  }
+  difference_type operator-(
+      const circular_buffer_iterator& other) const noexcept {
+    return static_cast<difference_type>(index_) -
+           static_cast<difference_type>(other.index_);
+  }
+
+  friend bool operator==(const circular_buffer_iterator& a,
+                         const circular_buffer_iterator& b) noexcept {
+    return a.data_ == b.data_ && a.index_ == b.index_;
+  }
+  friend bool operator!=(const circular_buffer_iterator& a,
+                         const circular_buffer_iterator& b) noexcept {
+    return !(a == b);
+  }
+  friend bool operator<(const circular_buffer_iterator& a,
+                        const circular_buffer_iterator& b) noexcept {
+    return a.index_ < b.index_;
+  }
+  friend bool operator>(const circular_buffer_iterator& a,
+                        const circular_buffer_iterator& b) noexcept {
+    return b < a;
+  }
+  friend bool operator<=(const circular_buffer_iterator& a,
+                         const circular_buffer_iterator& b) noexcept {
+    return !(b < a);
+  }
+  friend bool operator>=(const circular_buffer_iterator& a,
+                         const circular_buffer_iterator& b) noexcept {
+    return !(a < b);
+  }
+
+ private:
+  template <typename>
+  friend class circular_buffer_iterator;
+
+  size_type physical(size_type index) const noexcept {
+    size_type pos = head_ + index;
+    return pos < capacity_ ? pos : pos - capacity_;
+  }
+
+  pointer data_{};
+  size_type capacity_{};
+  size_type head_{};
+  size_type index_{};
+};
+
+}
@@ -3,7 +3,31 @@
 #include "list.h"
 #include "vector.h"
 #include "stack.h"
+#include "lockfree_stack.h"
 #include "queue.h"
+#include "channel.h"
+#include "async_queue.h"
 #include "map.h"
 #include "set.h"
+#include "multiset.h"
+#include "multimap.h"
 #include "array.h"
+#include "circular_buffer.h"
+#include "dense_int_map.h"
+#include "hyperloglog.h"
+#include "count_min_sketch.h"
+#include "heavy_hitters.h"
+#include "counter_map.h"
+#include "slot_map.h"
+#include "sparse_set.h"
+#include "fenwick_tree.h"
+#include "segment_tree.h"
+#include "radix_tree.h"
+#include "string_pool.h"
+#include "small_string.h"
+#include "rope.h"
+#include "ndarray.h"
+#include "matrix.h"
+#include "csr_graph.h"
+#include "csr_matrix.h"
+#include "latency.h"
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "fast_hash.h"
+
+namespace containers {
+
+template <typename K, typename H = fast_hash<K>>
+class count_min_sketch {
+ public:
+  using key_type = K;
+  using hasher = H;
+  using counter_type = uint64_t;
+  using size_type = size_t;
+
+  static constexpr size_type batch_size = 16;
+
+  count_min_sketch(size_type width, size_type depth);
+  count_min_sketch(const count_min_sketch& other);
+  count_min_sketch(count_min_sketch&& other) noexcept;
+  ~count_min_sketch() = default;
+
+  count_min_sketch& operator=(const count_min_sketch& other);
+  count_min_sketch& operator=(count_min_sketch&& other) noexcept;
+
+  static count_min_sketch from_error(double epsilon, double delta);
+
+  size_type width() const noexcept { return width_; }
+  size_type depth() const noexcept { return depth_; }
+  counter_type total() const noexcept { return total_; }
+  void clear();
+
+  counter_type update(const key_type& key, counter_type count = 1);
+  template <typename InputIt>
+  void update(InputIt first, InputIt last);
+  counter_type estimate(const key_type& key) const;
+
+  void merge(const count_min_sketch& other);
+  void swap(count_min_sketch& other) noexcept;
+
+ private:
+  counter_type update_hash(uint64_t hash, counter_type count);
+  counter_type estimate_hash(uint64_t hash) const noexcept;
+  static uint64_t step_for(uint64_t hash) noexcept {
+    return hash_int(hash) | 1;
+  }
+  counter_type* cell(uint64_t hash, uint64_t step, size_type row) const
+      noexcept {
+    return counters_.get() + row * width_ +
+           ((hash + row * step) & (width_ - 1));
+  }
+
+  size_type width_;
+  size_type depth_;
+  counter_type total_{0};
+  std::unique_ptr<counter_type[]> counters_;
+};
+
+template <typename K, typename H>
+count_min_sketch<K, H>::count_min_sketch(size_type width, size_type depth)
+    : width_(1), depth_(depth) {
+  if (!width || !depth) {
+    throw std::out_of_range("Error: sketch dimensions must be positive");
+  }
+  while (width_ < width) {
+    width_ <<= 1;
+  }
+  try {
+    counters_.reset(new counter_type[width_ * depth_]());
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+}
+
+template <typename K, typename H>
+count_min_sketch<K, H>::count_min_sketch(const count_min_sketch& other)
+    : count_min_sketch(other.width_, other.depth_) {
+  total_ = other.total_;
+  std::copy_n(other.counters_.get(), width_ * depth_, counters_.get());
+}
+
+template <typename K, typename H>
+count_min_sketch<K, H>::count_min_sketch(count_min_sketch&& other) noexcept
+    : width_(other.width_),
+      depth_(other.depth_),
+      total_(other.total_),
+      counters_(std::move(other.counters_)) {
+  other.total_ = 0;
+}
+
+template <typename K, typename H>
+count_min_sketch<K, H>& count_min_sketch<K, H>::operator=(
+    const count_min_sketch& other) {
+  if (this != &other) {
+    count_min_sketch tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename H>
+count_min_sketch<K, H>& count_min_sketch<K, H>::operator=(
+    count_min_sketch&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename K, typename H>
+count_min_sketch<K, H> count_min_sketch<K, H>::from_error(double epsilon,
+                                                         double delta) {
+  if (epsilon <= 0 || delta <= 0 || delta >= 1) {
+    throw std::out_of_range("Error: sketch error bounds out of range");
+  }
+  return count_min_sketch(
+      static_cast<size_type>(std::ceil(std::exp(1.0) / epsilon)),
+      static_cast<size_type>(std::ceil(std::log(1.0 / delta))));
+}
+
+template <typename K, typename H>
+void count_min_sketch<K, H>::clear() {
+  std::fill_n(counters_.get(), width_ * depth_, counter_type{0});
+  total_ = 0;
+}
+
+template <typename K, typename H>
+typename count_min_sketch<K, H>::counter_type
+count_min_sketch<K, H>::estimate_hash(uint64_t hash) const noexcept {
+  uint64_t step = step_for(hash);
+  counter_type result = *cell(hash, step, 0);
+  for (size_type row = 1; row < depth_; ++row) {
+    result = std::min(result, *cell(hash, step, row));
+  }
+  return result;
+}
+
+template <typename K, typename H>
+typename count_min_sketch<K, H>::counter_type
+count_min_sketch<K, H>::update_hash(uint64_t hash, counter_type count) {
+  // Conservative update: only raise the rows that would fall below the new
+  // minimum estimate, which keeps collisions from inflating every row.
+  counter_type target = estimate_hash(hash) + count;
+  uint64_t step = step_for(hash);
+  for (size_type row = 0; row < depth_; ++row) {
+    counter_type* c = cell(hash, step, row);
+    *c = std::max(*c, target);
+  }
+  total_ += count;
+  return target;
+}
+
+template <typename K, typename H>
+typename count_min_sketch<K, H>::counter_type count_min_sketch<K, H>::update(
+    const key_type& key, counter_type count) {
+  return update_hash(hasher{}(key), count);
+}
+
+template <typename K, typename H>
+template <typename InputIt>
+void count_min_sketch<K, H>::update(InputIt first, InputIt last) {
+  uint64_t hashes[batch_size];
+  while (first != last) {
+    size_type n = 0;
+    for (; n < batch_size && first != last; ++n, ++first) {
+      hashes[n] = hasher{}(*first);
+      uint64_t step = step_for(hashes[n]);
+      for (size_type row = 0; row < depth_; ++row) {
+        __builtin_prefetch(cell(hashes[n], step, row), 1);
+      }
+    }
+    for (size_type i = 0; i < n; ++i) {
+      update_hash(hashes[i], 1);
+    }
+  }
+}
+
+template <typename K, typename H>
+typename count_min_sketch<K, H>::counter_type count_min_sketch<K, H>::estimate(
+    const key_type& key) const {
+  return estimate_hash(hasher{}(key));
+}
+
+template <typename K, typename H>
+void count_min_sketch<K, H>::merge(const count_min_sketch& other) {
+  if (width_ != other.width_ || depth_ != other.depth_) {
+    throw std::runtime_error("Error: sketch dimensions mismatch");
+  }
+  for (size_type i = 0; i < width_ * depth_; ++i) {
+    counters_[i] += other.counters_[i];
+  }
+  total_ += other.total_;
+}
+
+template <typename K, typename H>
+void count_min_sketch<K, H>::swap(count_min_sketch& other) noexcept {
+  std::swap(width_, other.width_);
+  std::swap(depth_, other.depth_);
+  std::swap(total_, other.total_);
+  counters_.swap(other.counters_);
+}
+
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "count_min_sketch.h"
+#include "hash_table.h"
+#include "vector.h"
+
+namespace containers {
+
+template <typename K, typename H = fast_hash<K>>
+class heavy_hitters {
+ public:
+  using key_type = K;
+  using hasher = H;
+  using sketch = count_min_sketch<K, H>;
+  using counter_type = typename sketch::counter_type;
+  using value_type = std::pair<key_type, counter_type>;
+  using size_type = size_t;
+
+  heavy_hitters(size_type k, size_type width, size_type depth)
+      : k_(k), sketch_(width, depth) {}
+  heavy_hitters(size_type k, sketch s) : k_(k), sketch_(std::move(s)) {}
+
+  size_type capacity() const noexcept { return k_; }
+  size_type size() const noexcept { return heap_.size(); }
+  bool empty() const noexcept { return heap_.empty(); }
+  counter_type total() const noexcept { return sketch_.total(); }
+  const sketch& counts() const noexcept { return sketch_; }
+  void clear();
+
+  void update(const key_type& key, counter_type count = 1);
+  template <typename InputIt>
+  void update(InputIt first, InputIt last);
+  counter_type estimate(const key_type& key) const {
+    return sketch_.estimate(key);
+  }
+
+  bool contains(const key_type& key) const noexcept {
+    return index_.contains(key);
+  }
+  Vector<value_type> top() const;
+
+  void merge(const heavy_hitters& other);
+  void swap(heavy_hitters& other);
+
+ private:
+  void track(const key_type& key, counter_type estimate);
+  void place(size_type pos, const value_type& entry);
+  void sift_up(size_type pos);
+  void sift_down(size_type pos);
+
+  size_type k_;
+  sketch sketch_;
+  Vector<value_type> heap_;
+  hash_table<K, size_type, H> index_;
+};
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::clear() {
+  sketch_.clear();
+  heap_.clear();
+  index_.clear();
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::update(const key_type& key, counter_type count) {
+  track(key, sketch_.update(key, count));
+}
+
+template <typename K, typename H>
+template <typename InputIt>
+void heavy_hitters<K, H>::update(InputIt first, InputIt last) {
+  // Keys go through the sketch's prefetching batch path first; the top-K
+  // is refreshed afterwards from the estimates of the same batch.
+  Vector<key_type> batch;
+  batch.reserve(sketch::batch_size);
+  while (first != last) {
+    batch.clear();
+    for (; batch.size() < sketch::batch_size && first != last; ++first) {
+      batch.push_back(*first);
+    }
+    const key_type* keys = batch.data();
+    sketch_.update(keys, keys + batch.size());
+    for (size_type i = 0; i < batch.size(); ++i) {
+      track(keys[i], sketch_.estimate(keys[i]));
+    }
+  }
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::track(const key_type& key, counter_type estimate) {
+  if (!k_) return;
+
+  // A tracked key's estimate never drops below the heap minimum, so smaller
+  // estimates can skip the index lookup entirely.
+  bool full = heap_.size() == k_;
+  if (full && estimate <= heap_[0].second) return;
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    size_type pos = it->second;
+    heap_[pos].second = estimate;
+    sift_down(pos);
+    return;
+  }
+
+  if (!full) {
+    heap_.push_back({key, estimate});
+    index_[key] = heap_.size() - 1;
+    sift_up(heap_.size() - 1);
+    return;
+  }
+
+  index_.replace_key(index_.find(heap_[0].first), key);
+  heap_[0] = {key, estimate};
+  sift_down(0);
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::place(size_type pos, const value_type& entry) {
+  heap_[pos] = entry;
+  index_[entry.first] = pos;
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::sift_up(size_type pos) {
+  value_type entry = heap_[pos];
+  while (pos) {
+    size_type parent = (pos - 1) / 2;
+    if (heap_[parent].second <= entry.second) break;
+    place(pos, heap_[parent]);
+    pos = parent;
+  }
+  place(pos, entry);
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::sift_down(size_type pos) {
+  value_type entry = heap_[pos];
+  size_type count = heap_.size();
+  for (size_type child = 2 * pos + 1; child < count; child = 2 * pos + 1) {
+    if (child + 1 < count && heap_[child + 1].second < heap_[child].second) {
+      ++child;
+    }
+    if (entry.second <= heap_[child].second) break;
+    place(pos, heap_[child]);
+    pos = child;
+  }
+  place(pos, entry);
+}
+
+template <typename K, typename H>
+Vector<typename heavy_hitters<K, H>::value_type> heavy_hitters<K, H>::top()
+    const {
+  Vector<value_type> result(heap_);
+  std::sort(result.data(), result.data() + result.size(),
+            [](const value_type& a, const value_type& b) {
+              return a.second > b.second;
+            });
+  return result;
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::merge(const heavy_hitters& other) {
+  sketch_.merge(other.sketch_);
+
+  Vector<key_type> candidates;
+  for (size_type i = 0; i < heap_.size(); ++i) {
+    candidates.push_back(heap_[i].first);
+  }
+  for (size_type i = 0; i < other.heap_.size(); ++i) {
+    candidates.push_back(other.heap_[i].first);
+  }
+
+  heap_.clear();
+  index_.clear();
+  for (size_type i = 0; i < candidates.size(); ++i) {
+    track(candidates[i], sketch_.estimate(candidates[i]));
+  }
+}
+
+template <typename K, typename H>
+void heavy_hitters<K, H>::swap(heavy_hitters& other) {
+  std::swap(k_, other.k_);
+  sketch_.swap(other.sketch_);
+  heap_.swap(other.heap_);
+  index_.swap(other.index_);
+}
+
+}
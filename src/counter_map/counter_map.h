@@ -0,0 +1,321 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include "fast_hash.h"
+#include "map.h"
+#include "vector.h"
+
+namespace containers {
+
+constexpr size_t default_counter_shards = 64;
+constexpr size_t default_delta_buffer_size = 256;
+constexpr size_t default_delta_buffer_updates = 4096;
+
+template <typename K, typename H = fast_hash<K>,
+          size_t Shards = default_counter_shards>
+class counter_map {
+  static_assert(Shards && !(Shards & (Shards - 1)),
+                "counter_map shard count must be a power of two");
+
+ public:
+  using key_type = K;
+  using mapped_type = int64_t;
+  using value_type = std::pair<key_type, mapped_type>;
+  using hasher = H;
+  using size_type = size_t;
+
+  class delta_buffer;
+
+  counter_map() = default;
+  counter_map(const counter_map& other) = delete;
+  counter_map(counter_map&& other) = delete;
+  ~counter_map();
+
+  counter_map& operator=(const counter_map& other) = delete;
+  counter_map& operator=(counter_map&& other) = delete;
+
+  size_type size() const noexcept;
+  bool empty() const noexcept { return !size(); }
+
+  mapped_type add(const key_type& key, mapped_type delta = 1);
+  mapped_type increment(const key_type& key) { return add(key, 1); }
+  mapped_type get(const key_type& key) const noexcept;
+  bool contains(const key_type& key) const noexcept;
+  void reset() noexcept;
+
+  // Weakly consistent: every counter is read atomically, but adds and
+  // inserts that race with the scan may or may not be reflected, so the
+  // result is not a point-in-time view across keys.
+  Vector<value_type> scan() const;
+  // Point-in-time view for export: holds every shard exclusively while the
+  // counters are copied, so concurrent adds wait for it to finish.
+  Vector<value_type> snapshot() const;
+  delta_buffer buffer(size_type capacity = default_delta_buffer_size,
+                      size_type max_updates = default_delta_buffer_updates) {
+    return delta_buffer(*this, capacity, max_updates);
+  }
+
+ private:
+  struct node {
+    explicit node(const key_type& k) : key(k) {}
+
+    alignas(cache_line_size) std::atomic<mapped_type> value{0};
+    const key_type key;
+  };
+
+  struct table {
+    explicit table(size_type n)
+        : capacity(n), slots(new std::atomic<node*>[n]()) {}
+
+    size_type capacity;
+    std::unique_ptr<std::atomic<node*>[]> slots;
+    std::unique_ptr<table> previous;
+  };
+
+  // add() holds the lock shared only around its fetch_add, so adds never
+  // contend with each other; insert() and snapshot() hold it exclusively.
+  struct alignas(cache_line_size) shard {
+    mutable std::shared_mutex lock;
+    std::atomic<table*> current{nullptr};
+    std::atomic<size_type> size{0};
+    std::unique_ptr<table> owner;
+  };
+
+  static constexpr size_type min_capacity = 16;
+  static constexpr int shard_shift =
+      Shards == 1 ? 0 : 64 - __builtin_ctzll(Shards);
+
+  shard& shard_for(uint64_t hash) noexcept {
+    return shards_[(hash >> shard_shift) & (Shards - 1)];
+  }
+  const shard& shard_for(uint64_t hash) const noexcept {
+    return shards_[(hash >> shard_shift) & (Shards - 1)];
+  }
+  static node* lookup(const table* t, const key_type& key,
+                      uint64_t hash) noexcept;
+  static void place(table* t, node* n, uint64_t hash) noexcept;
+  node* insert(shard& s, const key_type& key, uint64_t hash);
+  void grow(shard& s);
+
+  shard shards_[Shards];
+};
+
+template <typename K, typename H, size_t S>
+class counter_map<K, H, S>::delta_buffer {
+ public:
+  delta_buffer(const delta_buffer& other) = delete;
+  delta_buffer(delta_buffer&& other) noexcept
+      : map_(other.map_),
+        capacity_(other.capacity_),
+        max_updates_(other.max_updates_),
+        distinct_(other.distinct_),
+        updates_(other.updates_),
+        pending_(std::move(other.pending_)) {
+    other.map_ = nullptr;
+  }
+  ~delta_buffer() { flush(); }
+
+  delta_buffer& operator=(const delta_buffer& other) = delete;
+  delta_buffer& operator=(delta_buffer&& other) = delete;
+
+  size_type size() const noexcept { return distinct_; }
+
+  // Flushes once capacity distinct keys are pending, or after max_updates
+  // adds so that a single hot key is still published regularly.
+  void add(const key_type& key, mapped_type delta = 1) {
+    mapped_type& pending = pending_[key];
+    if (!pending) ++distinct_;
+    pending += delta;
+    if (distinct_ >= capacity_ || ++updates_ >= max_updates_) {
+      flush();
+    }
+  }
+
+  // Published keys stay in the buffer with a zero delta, so hot keys do not
+  // reallocate their entry after every flush. The cached keys are dropped
+  // once they outgrow twice the capacity.
+  void flush() {
+    if (!map_) return;
+    for (auto& it : pending_) {
+      if (it.second) {
+        map_->add(it.first, it.second);
+        it.second = 0;
+      }
+    }
+    if (pending_.size() >= 2 * capacity_) {
+      pending_.clear();
+    }
+    distinct_ = updates_ = 0;
+  }
+
+ private:
+  friend class counter_map;
+
+  delta_buffer(counter_map& map, size_type capacity, size_type max_updates)
+      : map_(&map),
+        capacity_(capacity ? capacity : 1),
+        max_updates_(max_updates ? max_updates : 1) {}
+
+  counter_map* map_;
+  size_type capacity_;
+  size_type max_updates_;
+  size_type distinct_{0};
+  size_type updates_{0};
+  Map<key_type, mapped_type, hasher> pending_;
+};
+
+template <typename K, typename H, size_t S>
+counter_map<K, H, S>::~counter_map() {
+  for (auto& s : shards_) {
+    table* t = s.owner.get();
+    if (!t) continue;
+    for (size_type i = 0; i < t->capacity; ++i) {
+      delete t->slots[i].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename K, typename H, size_t S>
+typename counter_map<K, H, S>::size_type counter_map<K, H, S>::size()
+    const noexcept {
+  size_type result = 0;
+  for (auto& s : shards_) {
+    result += s.size.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+template <typename K, typename H, size_t S>
+typename counter_map<K, H, S>::node* counter_map<K, H, S>::lookup(
+    const table* t, const key_type& key, uint64_t hash) noexcept {
+  if (!t) return nullptr;
+
+  size_type mask = t->capacity - 1;
+  for (size_type i = hash & mask;; i = (i + 1) & mask) {
+    node* n = t->slots[i].load(std::memory_order_acquire);
+    if (!n || n->key == key) return n;
+  }
+}
+
+template <typename K, typename H, size_t S>
+void counter_map<K, H, S>::place(table* t, node* n, uint64_t hash) noexcept {
+  size_type mask = t->capacity - 1;
+  size_type i = hash & mask;
+  while (t->slots[i].load(std::memory_order_relaxed)) {
+    i = (i + 1) & mask;
+  }
+  t->slots[i].store(n, std::memory_order_release);
+}
+
+template <typename K, typename H, size_t S>
+void counter_map<K, H, S>::grow(shard& s) {
+  table* old = s.owner.get();
+  auto next = std::make_unique<table>(old ? old->capacity * 2 : min_capacity);
+  if (old) {
+    for (size_type i = 0; i < old->capacity; ++i) {
+      node* n = old->slots[i].load(std::memory_order_relaxed);
+      if (n) place(next.get(), n, hasher{}(n->key));
+    }
+  }
+
+  // Readers may still be probing the old table, so it stays alive until the
+  // map is destroyed.
+  next->previous = std::move(s.owner);
+  s.owner = std::move(next);
+  s.current.store(s.owner.get(), std::memory_order_release);
+}
+
+template <typename K, typename H, size_t S>
+typename counter_map<K, H, S>::node* counter_map<K, H, S>::insert(
+    shard& s, const key_type& key, uint64_t hash) {
+  std::lock_guard<std::shared_mutex> guard(s.lock);
+  node* n = lookup(s.owner.get(), key, hash);
+  if (n) return n;
+
+  size_type count = s.size.load(std::memory_order_relaxed);
+  if (!s.owner || (count + 1) * 4 > s.owner->capacity * 3) {
+    grow(s);
+  }
+
+  auto created = std::make_unique<node>(key);
+  place(s.owner.get(), created.get(), hash);
+  s.size.store(count + 1, std::memory_order_relaxed);
+  return created.release();
+}
+
+template <typename K, typename H, size_t S>
+typename counter_map<K, H, S>::mapped_type counter_map<K, H, S>::add(
+    const key_type& key, mapped_type delta) {
+  uint64_t hash = hasher{}(key);
+  shard& s = shard_for(hash);
+  node* n = lookup(s.current.load(std::memory_order_acquire), key, hash);
+  if (!n) {
+    n = insert(s, key, hash);
+  }
+  std::shared_lock<std::shared_mutex> guard(s.lock);
+  return n->value.fetch_add(delta, std::memory_order_relaxed) + delta;
+}
+
+template <typename K, typename H, size_t S>
+typename counter_map<K, H, S>::mapped_type counter_map<K, H, S>::get(
+    const key_type& key) const noexcept {
+  uint64_t hash = hasher{}(key);
+  const shard& s = shard_for(hash);
+  node* n = lookup(s.current.load(std::memory_order_acquire), key, hash);
+  return n ? n->value.load(std::memory_order_relaxed) : 0;
+}
+
+template <typename K, typename H, size_t S>
+bool counter_map<K, H, S>::contains(const key_type& key) const noexcept {
+  uint64_t hash = hasher{}(key);
+  const shard& s = shard_for(hash);
+  return lookup(s.current.load(std::memory_order_acquire), key, hash);
+}
+
+template <typename K, typename H, size_t S>
+void counter_map<K, H, S>::reset() noexcept {
+  for (auto& s : shards_) {
+    table* t = s.current.load(std::memory_order_acquire);
+    if (!t) continue;
+    for (size_type i = 0; i < t->capacity; ++i) {
+      node* n = t->slots[i].load(std::memory_order_acquire);
+      if (n) n->value.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename K, typename H, size_t S>
+Vector<typename counter_map<K, H, S>::value_type>
+counter_map<K, H, S>::scan() const {
+  Vector<value_type> result;
+  result.reserve(size());
+  for (auto& s : shards_) {
+    const table* t = s.current.load(std::memory_order_acquire);
+    if (!t) continue;
+    for (size_type i = 0; i < t->capacity; ++i) {
+      node* n = t->slots[i].load(std::memory_order_acquire);
+      if (n) {
+        result.push_back({n->key, n->value.load(std::memory_order_relaxed)});
+      }
+    }
+  }
+  return result;
+}
+
+template <typename K, typename H, size_t S>
+Vector<typename counter_map<K, H, S>::value_type>
+counter_map<K, H, S>::snapshot() const {
+  std::unique_lock<std::shared_mutex> guards[S];
+  for (size_type i = 0; i < S; ++i) {
+    guards[i] = std::unique_lock<std::shared_mutex>(shards_[i].lock);
+  }
+  return scan();
+}
+
+}
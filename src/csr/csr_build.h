@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "vector.h"
+#include "vector_parallel.h"
+
+namespace containers {
+
+template <typename T>
+class csr_span {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using const_iterator = const T*;
+
+  csr_span() = default;
+  csr_span(const T* first, const T* last) noexcept
+      : first_(first), last_(last) {}
+
+  const_iterator begin() const noexcept { return first_; }
+  const_iterator end() const noexcept { return last_; }
+  const T* data() const noexcept { return first_; }
+  size_type size() const noexcept { return last_ - first_; }
+  bool empty() const noexcept { return first_ == last_; }
+  const T& operator[](size_type pos) const noexcept { return first_[pos]; }
+
+ private:
+  const T* first_{nullptr};
+  const T* last_{nullptr};
+};
+
+namespace csr {
+
+// Splits [0, n) into contiguous parts and runs f(part, begin, end) for each
+// of them, the first one on the calling thread. If a worker fails to start,
+// the ones already running are joined before the error propagates.
+template <typename Function>
+void for_each_part(size_t n, size_t parts, Function f) {
+  size_t chunk = (n + parts - 1) / parts;
+  std::vector<std::thread> workers;
+  try {
+    workers.reserve(parts - 1);
+    for (size_t part = 1; part < parts; ++part) {
+      workers.emplace_back(f, part, std::min(n, part * chunk),
+                           std::min(n, (part + 1) * chunk));
+    }
+  } catch (...) {
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    throw;
+  }
+  f(0, 0, std::min(n, chunk));
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// Stable counting sort of records by row. Each part counts its own slice,
+// the per-part histograms are turned into disjoint write cursors, and every
+// part then scatters its slice without synchronisation. offsets receives
+// rows + 1 entries; emit(position, record) stores a record at its slot.
+// The number of parts is capped at count / (rows + 1) so the histograms
+// never outweigh the records themselves.
+template <typename Record, typename RowOf, typename Valid, typename Emit>
+void counting_sort(const Record* records, size_t count, size_t rows,
+                   Vector<size_t>& offsets, RowOf row_of, Valid valid,
+                   Emit emit, const parallel_policy& policy) {
+  size_t parts = 1;
+  if (policy.threads > 1 && count * sizeof(Record) >= policy.threshold) {
+    parts = std::max<size_t>(1, std::min(policy.threads, count / (rows + 1)));
+  }
+
+  std::vector<Vector<size_t>> cursors;
+  for (size_t part = 0; part < parts; ++part) {
+    cursors.emplace_back(rows);
+  }
+
+  std::atomic<bool> invalid{false};
+  for_each_part(count, parts, [&](size_t part, size_t begin, size_t end) {
+    size_t* histogram = cursors[part].data();
+    for (size_t i = begin; i < end; ++i) {
+      if (!valid(records[i])) {
+        invalid.store(true, std::memory_order_relaxed);
+        return;
+      }
+      ++histogram[row_of(records[i])];
+    }
+  });
+  if (invalid.load(std::memory_order_relaxed)) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  // Exclusive prefix sum over (row, part) pairs, split into row ranges:
+  // every range sums its counts, the range totals are scanned, and each
+  // range then rewrites its counts into write cursors.
+  Vector<size_t> result(rows + 1);
+  Vector<size_t> starts(parts);
+  for_each_part(rows, parts, [&](size_t range, size_t begin, size_t end) {
+    size_t sum = 0;
+    for (size_t row = begin; row < end; ++row) {
+      for (size_t part = 0; part < parts; ++part) {
+        sum += cursors[part].data()[row];
+      }
+    }
+    starts.data()[range] = sum;
+  });
+  size_t total = 0;
+  for (size_t range = 0; range < parts; ++range) {
+    size_t sum = starts.data()[range];
+    starts.data()[range] = total;
+    total += sum;
+  }
+  for_each_part(rows, parts, [&](size_t range, size_t begin, size_t end) {
+    size_t running = starts.data()[range];
+    for (size_t row = begin; row < end; ++row) {
+      result.data()[row] = running;
+      for (size_t part = 0; part < parts; ++part) {
+        size_t& cursor = cursors[part].data()[row];
+        size_t counted = cursor;
+        cursor = running;
+        running += counted;
+      }
+    }
+  });
+  result.data()[rows] = total;
+
+  for_each_part(count, parts, [&](size_t part, size_t begin, size_t end) {
+    size_t* cursor = cursors[part].data();
+    for (size_t i = begin; i < end; ++i) {
+      emit(cursor[row_of(records[i])]++, records[i]);
+    }
+  });
+  offsets = std::move(result);
+}
+
+}  // namespace csr
+
+}
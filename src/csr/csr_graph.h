@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "csr_build.h"
+
+namespace containers {
+
+template <typename Vertex = uint32_t>
+class csr_graph {
+ public:
+  using vertex_type = Vertex;
+  using edge_type = std::pair<vertex_type, vertex_type>;
+  using level_type = uint32_t;
+  using size_type = size_t;
+
+  static constexpr level_type unreachable =
+      std::numeric_limits<level_type>::max();
+
+  csr_graph() = default;
+  csr_graph(size_type vertices, const Vector<edge_type>& edges,
+            const parallel_policy& policy = {});
+
+  size_type vertex_count() const noexcept {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+  size_type edge_count() const noexcept { return targets_.size(); }
+  size_type degree(vertex_type v) const noexcept {
+    return offsets_.data()[v + 1] - offsets_.data()[v];
+  }
+  csr_span<vertex_type> neighbors(vertex_type v) const noexcept {
+    const vertex_type* targets = targets_.data();
+    return {targets + offsets_.data()[v], targets + offsets_.data()[v + 1]};
+  }
+  const Vector<size_type>& offsets() const noexcept { return offsets_; }
+  const Vector<vertex_type>& targets() const noexcept { return targets_; }
+
+  Vector<vertex_type> expand(const Vector<vertex_type>& frontier,
+                             Vector<level_type>& levels,
+                             level_type depth) const;
+  Vector<level_type> bfs(vertex_type source) const;
+
+ private:
+  Vector<size_type> offsets_;
+  Vector<vertex_type> targets_;
+};
+
+template <typename V>
+csr_graph<V>::csr_graph(size_type vertices, const Vector<edge_type>& edges,
+                        const parallel_policy& policy)
+    : targets_(edges.size(), vertex_type{}, policy) {
+  if (vertices &&
+      vertices - 1 > size_type{std::numeric_limits<vertex_type>::max()}) {
+    throw std::out_of_range("Error: too many vertices for vertex_type");
+  }
+
+  vertex_type* targets = targets_.data();
+  csr::counting_sort(
+      edges.data(), edges.size(), vertices, offsets_,
+      [](const edge_type& e) { return static_cast<size_type>(e.first); },
+      [vertices](const edge_type& e) {
+        return static_cast<size_type>(e.first) < vertices &&
+               static_cast<size_type>(e.second) < vertices;
+      },
+      [targets](size_type pos, const edge_type& e) {
+        targets[pos] = e.second;
+      },
+      policy);
+}
+
+template <typename V>
+Vector<typename csr_graph<V>::vertex_type> csr_graph<V>::expand(
+    const Vector<vertex_type>& frontier, Vector<level_type>& levels,
+    level_type depth) const {
+  Vector<vertex_type> next;
+  level_type* level = levels.data();
+  const size_type* offsets = offsets_.data();
+  const vertex_type* targets = targets_.data();
+  for (size_type i = 0; i < frontier.size(); ++i) {
+    vertex_type v = frontier.data()[i];
+    for (size_type e = offsets[v]; e < offsets[v + 1]; ++e) {
+      vertex_type u = targets[e];
+      if (level[u] == unreachable) {
+        level[u] = depth;
+        next.push_back(u);
+      }
+    }
+  }
+  return next;
+}
+
+template <typename V>
+Vector<typename csr_graph<V>::level_type> csr_graph<V>::bfs(
+    vertex_type source) const {
+  if (static_cast<size_type>(source) >= vertex_count()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  Vector<level_type> levels(vertex_count(), unreachable);
+  levels.data()[source] = 0;
+  Vector<vertex_type> frontier{source};
+  for (level_type depth = 1; !frontier.empty(); ++depth) {
+    frontier = expand(frontier, levels, depth);
+  }
+  return levels;
+}
+
+}
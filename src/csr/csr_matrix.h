@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "csr_build.h"
+
+namespace containers {
+
+template <typename T, typename Index = uint32_t>
+class csr_matrix {
+ public:
+  using value_type = T;
+  using index_type = Index;
+  using size_type = size_t;
+
+  struct entry {
+    size_type row;
+    index_type col;
+    value_type value;
+  };
+
+  csr_matrix() = default;
+  csr_matrix(size_type rows, size_type cols, const Vector<entry>& entries,
+             const parallel_policy& policy = {});
+
+  size_type rows() const noexcept {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+  size_type cols() const noexcept { return cols_; }
+  size_type nonzeros() const noexcept { return values_.size(); }
+
+  csr_span<index_type> row_indices(size_type row) const noexcept {
+    const index_type* cols = indices_.data();
+    return {cols + offsets_.data()[row], cols + offsets_.data()[row + 1]};
+  }
+  csr_span<value_type> row_values(size_type row) const noexcept {
+    const value_type* values = values_.data();
+    return {values + offsets_.data()[row],
+            values + offsets_.data()[row + 1]};
+  }
+  const Vector<size_type>& offsets() const noexcept { return offsets_; }
+  const Vector<index_type>& indices() const noexcept { return indices_; }
+  const Vector<value_type>& values() const noexcept { return values_; }
+
+  Vector<value_type> multiply(const Vector<value_type>& x,
+                              const parallel_policy& policy = {}) const;
+
+ private:
+  void multiply_rows(const value_type* x, value_type* y, size_type begin,
+                     size_type end) const noexcept;
+
+  size_type cols_{0};
+  Vector<size_type> offsets_;
+  Vector<index_type> indices_;
+  Vector<value_type> values_;
+};
+
+template <typename T, typename I>
+csr_matrix<T, I>::csr_matrix(size_type rows, size_type cols,
+                             const Vector<entry>& entries,
+                             const parallel_policy& policy)
+    : cols_(cols),
+      indices_(entries.size(), index_type{}, policy),
+      values_(entries.size(), value_type{}, policy) {
+  if (cols && cols - 1 > size_type{std::numeric_limits<index_type>::max()}) {
+    throw std::out_of_range("Error: too many columns for index_type");
+  }
+
+  index_type* indices = indices_.data();
+  value_type* values = values_.data();
+  csr::counting_sort(
+      entries.data(), entries.size(), rows, offsets_,
+      [](const entry& e) { return e.row; },
+      [rows, cols](const entry& e) {
+        return e.row < rows && static_cast<size_type>(e.col) < cols;
+      },
+      [indices, values](size_type pos, const entry& e) {
+        indices[pos] = e.col;
+        values[pos] = e.value;
+      },
+      policy);
+}
+
+template <typename T, typename I>
+void csr_matrix<T, I>::multiply_rows(const value_type* x, value_type* y,
+                                     size_type begin,
+                                     size_type end) const noexcept {
+  const size_type* offsets = offsets_.data();
+  const index_type* indices = indices_.data();
+  const value_type* values = values_.data();
+  for (size_type row = begin; row < end; ++row) {
+    value_type sum{};
+    for (size_type i = offsets[row]; i < offsets[row + 1]; ++i) {
+      sum += values[i] * x[indices[i]];
+    }
+    y[row] = sum;
+  }
+}
+
+template <typename T, typename I>
+Vector<typename csr_matrix<T, I>::value_type> csr_matrix<T, I>::multiply(
+    const Vector<value_type>& x, const parallel_policy& policy) const {
+  if (x.size() != cols_) {
+    throw std::runtime_error("Error: matrix dimensions do not match");
+  }
+
+  Vector<value_type> y(rows());
+  if (!parallel::is_parallel<value_type>(nonzeros(), policy)) {
+    multiply_rows(x.data(), y.data(), 0, rows());
+  } else {
+    parallel::for_each_chunk(
+        y.data(), rows(), policy, [&](size_type begin, size_type count) {
+          multiply_rows(x.data(), y.data(), begin, begin + count);
+        });
+  }
+  return y;
+}
+
+}
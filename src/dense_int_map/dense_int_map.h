@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "dense_int_map_iterator.h"
+#include "fast_hash.h"
+#include "vector.h"
+
+namespace containers {
+
+template <typename K, typename V, K EmptyKey = std::numeric_limits<K>::max(),
+          K DeletedKey = std::numeric_limits<K>::max() - 1>
+class dense_int_map {
+  static_assert(std::is_integral_v<K>, "dense_int_map requires integral keys");
+  static_assert(EmptyKey != DeletedKey,
+                "Empty and deleted sentinel keys must differ");
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using iterator = dense_int_map_iterator<dense_int_map, V>;
+  using const_iterator = dense_int_map_iterator<const dense_int_map, const V>;
+  using size_type = size_t;
+
+  static constexpr key_type empty_key = EmptyKey;
+  static constexpr key_type deleted_key = DeletedKey;
+
+  dense_int_map() = default;
+  explicit dense_int_map(size_type expected);
+  dense_int_map(std::initializer_list<value_type> const& items);
+  dense_int_map(const dense_int_map& other);
+  dense_int_map(dense_int_map&& other) noexcept;
+  ~dense_int_map() = default;
+
+  dense_int_map& operator=(const dense_int_map& other);
+  dense_int_map& operator=(dense_int_map&& other) noexcept;
+
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return !size_; }
+  void clear();
+  void reserve(size_type expected);
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, slot_count()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, slot_count()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  mapped_type& at(const key_type& key);
+  const mapped_type& at(const key_type& key) const;
+  mapped_type& operator[](const key_type& key);
+
+  void erase(iterator pos);
+  size_type erase(const key_type& key);
+  void swap(dense_int_map& other) noexcept;
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const key_type& key,
+                                   const mapped_type& value);
+  std::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                             const mapped_type& value);
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  iterator find(const key_type& key);
+  const_iterator find(const key_type& key) const;
+  bool contains(const key_type& key) const noexcept;
+
+ private:
+  friend iterator;
+  friend const_iterator;
+
+  constexpr static size_type min_capacity = 16;
+
+  static bool is_special(key_type key) noexcept {
+    return key == EmptyKey || key == DeletedKey;
+  }
+  static size_type special_index(key_type key) noexcept {
+    return key == EmptyKey ? 0 : 1;
+  }
+  static bool fits(size_type count, size_type capacity) noexcept {
+    return count * 8 <= capacity * 7;
+  }
+
+  size_type slot_count() const noexcept { return capacity_ + 2; }
+  bool occupied(size_type index) const noexcept {
+    if (index < capacity_) return !is_special(keys_[index]);
+    return special_used_[index - capacity_];
+  }
+  const key_type& key_at(size_type index) const noexcept {
+    return index < capacity_ ? keys_[index] : special_keys_[index - capacity_];
+  }
+  mapped_type& value_at(size_type index) noexcept {
+    return index < capacity_ ? values_[index]
+                             : special_values_[index - capacity_];
+  }
+  const mapped_type& value_at(size_type index) const noexcept {
+    return index < capacity_ ? values_[index]
+                             : special_values_[index - capacity_];
+  }
+
+  size_type lookup(key_type key) const noexcept;
+  std::pair<size_type, bool> lookup_or_insert(key_type key);
+  void rehash(size_type new_capacity);
+
+  std::unique_ptr<key_type[]> keys_;
+  std::unique_ptr<mapped_type[]> values_;
+  size_type capacity_{0};
+  size_type size_{0};
+  size_type used_{0};
+  size_type tombstones_{0};
+  key_type special_keys_[2]{EmptyKey, DeletedKey};
+  mapped_type special_values_[2]{};
+  bool special_used_[2]{};
+};
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>::dense_int_map(size_type expected) {
+  reserve(expected);
+}
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>::dense_int_map(
+    std::initializer_list<value_type> const& items) {
+  reserve(items.size());
+  for (auto& it : items) {
+    (*this)[it.first] = it.second;
+  }
+}
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>::dense_int_map(const dense_int_map& other)
+    : capacity_(other.capacity_),
+      size_(other.size_),
+      used_(other.used_),
+      tombstones_(other.tombstones_) {
+  if (capacity_) {
+    keys_.reset(new key_type[capacity_]);
+    values_.reset(new mapped_type[capacity_]);
+    std::copy_n(other.keys_.get(), capacity_, keys_.get());
+    std::copy_n(other.values_.get(), capacity_, values_.get());
+  }
+  std::copy_n(other.special_values_, 2, special_values_);
+  std::copy_n(other.special_used_, 2, special_used_);
+}
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>::dense_int_map(dense_int_map&& other) noexcept {
+  swap(other);
+}
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>& dense_int_map<K, V, E, D>::operator=(
+    const dense_int_map& other) {
+  if (this != &other) {
+    dense_int_map tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, K E, K D>
+dense_int_map<K, V, E, D>& dense_int_map<K, V, E, D>::operator=(
+    dense_int_map&& other) noexcept {
+  if (this != &other) {
+    dense_int_map tmp{std::move(other)};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, K E, K D>
+void dense_int_map<K, V, E, D>::clear() {
+  dense_int_map tmp;
+  swap(tmp);
+}
+
+template <typename K, typename V, K E, K D>
+void dense_int_map<K, V, E, D>::reserve(size_type expected) {
+  if (!expected) return;
+
+  size_type capacity = std::max(capacity_, min_capacity);
+  while (!fits(expected, capacity)) {
+    capacity *= 2;
+  }
+  if (capacity != capacity_) {
+    rehash(capacity);
+  }
+}
+
+template <typename K, typename V, K E, K D>
+void dense_int_map<K, V, E, D>::rehash(size_type new_capacity) {
+  std::unique_ptr<key_type[]> keys;
+  std::unique_ptr<mapped_type[]> values;
+  try {
+    keys.reset(new key_type[new_capacity]);
+    values.reset(new mapped_type[new_capacity]());
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+  std::fill_n(keys.get(), new_capacity, E);
+
+  size_type mask = new_capacity - 1;
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (is_special(keys_[i])) continue;
+
+    size_type index = hash_int(static_cast<uint64_t>(keys_[i])) & mask;
+    while (keys[index] != E) {
+      index = (index + 1) & mask;
+    }
+    keys[index] = keys_[i];
+    values[index] = std::move(values_[i]);
+  }
+
+  keys_ = std::move(keys);
+  values_ = std::move(values);
+  capacity_ = new_capacity;
+  tombstones_ = 0;
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::size_type
+dense_int_map<K, V, E, D>::lookup(key_type key) const noexcept {
+  if (is_special(key)) {
+    size_type s = special_index(key);
+    return special_used_[s] ? capacity_ + s : slot_count();
+  }
+  if (!capacity_) {
+    return slot_count();
+  }
+
+  size_type mask = capacity_ - 1;
+  size_type index = hash_int(static_cast<uint64_t>(key)) & mask;
+  while (keys_[index] != E) {
+    if (keys_[index] == key) {
+      return index;
+    }
+    index = (index + 1) & mask;
+  }
+
+  return slot_count();
+}
+
+template <typename K, typename V, K E, K D>
+std::pair<typename dense_int_map<K, V, E, D>::size_type, bool>
+dense_int_map<K, V, E, D>::lookup_or_insert(key_type key) {
+  if (is_special(key)) {
+    size_type s = special_index(key);
+    bool inserted = !special_used_[s];
+    if (inserted) {
+      special_used_[s] = true;
+      ++size_;
+    }
+    return {capacity_ + s, inserted};
+  }
+
+  if (!fits(used_ + tombstones_ + 1, capacity_)) {
+    size_type capacity = std::max(capacity_, min_capacity);
+    rehash(fits(used_ + 1, capacity / 2) ? capacity : capacity * 2);
+  }
+
+  size_type mask = capacity_ - 1;
+  size_type index = hash_int(static_cast<uint64_t>(key)) & mask;
+  size_type tombstone = capacity_;
+  while (keys_[index] != E) {
+    if (keys_[index] == key) {
+      return {index, false};
+    }
+    if (keys_[index] == D && tombstone == capacity_) {
+      tombstone = index;
+    }
+    index = (index + 1) & mask;
+  }
+
+  if (tombstone != capacity_) {
+    index = tombstone;
+    --tombstones_;
+  }
+  keys_[index] = key;
+  ++used_;
+  ++size_;
+
+  return {index, true};
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::mapped_type&
+dense_int_map<K, V, E, D>::at(const key_type& key) {
+  size_type index = lookup(key);
+  if (index == slot_count()) {
+    throw std::out_of_range("Error: key doesn't exist");
+  }
+  return value_at(index);
+}
+
+template <typename K, typename V, K E, K D>
+const typename dense_int_map<K, V, E, D>::mapped_type&
+dense_int_map<K, V, E, D>::at(const key_type& key) const {
+  size_type index = lookup(key);
+  if (index == slot_count()) {
+    throw std::out_of_range("Error: key doesn't exist");
+  }
+  return value_at(index);
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::mapped_type&
+dense_int_map<K, V, E, D>::operator[](const key_type& key) {
+  return value_at(lookup_or_insert(key).first);
+}
+
+template <typename K, typename V, K E, K D>
+void dense_int_map<K, V, E, D>::erase(iterator pos) {
+  size_type index = pos.index();
+  if (index < capacity_) {
+    keys_[index] = D;
+    values_[index] = mapped_type{};
+    --used_;
+    ++tombstones_;
+  } else {
+    special_used_[index - capacity_] = false;
+    special_values_[index - capacity_] = mapped_type{};
+  }
+  --size_;
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::size_type dense_int_map<K, V, E, D>::erase(
+    const key_type& key) {
+  size_type index = lookup(key);
+  if (index == slot_count()) {
+    return 0;
+  }
+  erase(iterator(this, index));
+  return 1;
+}
+
+template <typename K, typename V, K E, K D>
+void dense_int_map<K, V, E, D>::swap(dense_int_map& other) noexcept {
+  std::swap(keys_, other.keys_);
+  std::swap(values_, other.values_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(used_, other.used_);
+  std::swap(tombstones_, other.tombstones_);
+  std::swap(special_values_, other.special_values_);
+  std::swap(special_used_, other.special_used_);
+}
+
+template <typename K, typename V, K E, K D>
+std::pair<typename dense_int_map<K, V, E, D>::iterator, bool>
+dense_int_map<K, V, E, D>::insert(const value_type& value) {
+  auto [index, inserted] = lookup_or_insert(value.first);
+  if (inserted) {
+    value_at(index) = value.second;
+  }
+  return {iterator(this, index), inserted};
+}
+
+template <typename K, typename V, K E, K D>
+std::pair<typename dense_int_map<K, V, E, D>::iterator, bool>
+dense_int_map<K, V, E, D>::insert(const key_type& key,
+                                  const mapped_type& value) {
+  return insert(std::make_pair(key, value));
+}
+
+template <typename K, typename V, K E, K D>
+std::pair<typename dense_int_map<K, V, E, D>::iterator, bool>
+dense_int_map<K, V, E, D>::insert_or_assign(const key_type& key,
+                                            const mapped_type& value) {
+  auto [index, inserted] = lookup_or_insert(key);
+  value_at(index) = value;
+  return {iterator(this, index), inserted};
+}
+
+template <typename K, typename V, K E, K D>
+template <typename... Args>
+Vector<std::pair<typename dense_int_map<K, V, E, D>::iterator, bool>>
+dense_int_map<K, V, E, D>::insert_many(Args&&... args) {
+  reserve(used_ + tombstones_ + sizeof...(args));
+  return {insert(std::forward<Args>(args))...};
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::iterator dense_int_map<K, V, E, D>::find(
+    const key_type& key) {
+  return iterator(this, lookup(key));
+}
+
+template <typename K, typename V, K E, K D>
+typename dense_int_map<K, V, E, D>::const_iterator
+dense_int_map<K, V, E, D>::find(const key_type& key) const {
+  return const_iterator(this, lookup(key));
+}
+
+template <typename K, typename V, K E, K D>
+bool dense_int_map<K, V, E, D>::contains(const key_type& key) const noexcept {
+  return lookup(key) != slot_count();
+}
+
+}
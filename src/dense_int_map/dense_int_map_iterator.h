@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace containers {
+
+template <typename Table, typename V>
+class dense_int_map_iterator {
+ public:
+  using key_type = typename Table::key_type;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, std::remove_const_t<V>>;
+  using reference = std::pair<const key_type&, V&>;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+  using size_type = size_t;
+
+  struct pointer {
+    reference ref;
+    reference* operator->() noexcept { return &ref; }
+  };
+
+  dense_int_map_iterator() = default;
+  dense_int_map_iterator(Table* table, size_type index) noexcept
+      : table_(table), index_(index) {
+    skip();
+  }
+  template <typename U, typename W,
+            typename = std::enable_if_t<!std::is_same_v<W, V>>>
+  dense_int_map_iterator(const dense_int_map_iterator<U, W>& other) noexcept
+      : table_(other.table_), index_(other.index_) {}
+
+  reference operator*() const noexcept {
+    return {table_->key_at(index_), table_->value_at(index_)};
+  }
+  pointer operator->() const noexcept { return pointer{**this}; }
+
+  dense_int_map_iterator& operator++() noexcept {
+    ++index_;
+    skip();
+    return *this;
+  }
+  dense_int_map_iterator operator++(int) noexcept {
+    auto tmp{*this};
+    ++(*this);
+    return tmp;
+  }
+
+  size_type index() const noexcept { return index_; }
+
+  friend bool operator==(const dense_int_map_iterator& a,
+                         const dense_int_map_iterator& b) noexcept {
+    return a.table_ == b.table_ && a.index_ == b.index_;
+  }
+  friend bool operator!=(const dense_int_map_iterator& a,
+                         const dense_int_map_iterator& b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  template <typename, typename>
+  friend class dense_int_map_iterator;
+
+  void skip() noexcept {
+    size_type last = table_->slot_count();
+    while (index_ < last && !table_->occupied(index_)) {
+      ++index_;
+    }
+  }
+
+  Table* table_{};
+  size_type index_{};
+};
+
+}
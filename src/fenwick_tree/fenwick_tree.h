@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdexcept>
+
+#include "vector.h"
+
+namespace containers {
+
+template <typename T>
+class fenwick_tree {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  fenwick_tree() = default;
+  explicit fenwick_tree(size_type count) : tree_(count + 1) {}
+  explicit fenwick_tree(const Vector<value_type>& values);
+
+  size_type size() const noexcept {
+    return tree_.empty() ? 0 : tree_.size() - 1;
+  }
+  bool empty() const noexcept { return !size(); }
+
+  void add(size_type pos, const value_type& delta);
+  void set(size_type pos, const value_type& value);
+  value_type get(size_type pos) const { return range_sum(pos, pos + 1); }
+
+  value_type prefix_sum(size_type count) const;
+  value_type range_sum(size_type first, size_type last) const;
+  size_type lower_bound(const value_type& target) const noexcept;
+
+ private:
+  static size_type low_bit(size_type i) noexcept { return i & (~i + 1); }
+
+  Vector<value_type> tree_;
+};
+
+template <typename T>
+fenwick_tree<T>::fenwick_tree(const Vector<value_type>& values)
+    : tree_(values.size() + 1) {
+  value_type* tree = tree_.data();
+  size_type count = values.size();
+  for (size_type i = 1; i <= count; ++i) {
+    tree[i] += values.data()[i - 1];
+    size_type parent = i + low_bit(i);
+    if (parent <= count) {
+      tree[parent] += tree[i];
+    }
+  }
+}
+
+template <typename T>
+void fenwick_tree<T>::add(size_type pos, const value_type& delta) {
+  if (pos >= size()) {
+    throw std::out_of_range("Error: fenwick_tree index out of range");
+  }
+  value_type* tree = tree_.data();
+  for (size_type i = pos + 1; i <= size(); i += low_bit(i)) {
+    tree[i] += delta;
+  }
+}
+
+template <typename T>
+void fenwick_tree<T>::set(size_type pos, const value_type& value) {
+  add(pos, value - get(pos));
+}
+
+template <typename T>
+typename fenwick_tree<T>::value_type fenwick_tree<T>::prefix_sum(
+    size_type count) const {
+  if (count > size()) {
+    throw std::out_of_range("Error: fenwick_tree index out of range");
+  }
+  const value_type* tree = tree_.data();
+  value_type result{};
+  for (size_type i = count; i; i -= low_bit(i)) {
+    result += tree[i];
+  }
+  return result;
+}
+
+template <typename T>
+typename fenwick_tree<T>::value_type fenwick_tree<T>::range_sum(
+    size_type first, size_type last) const {
+  if (first > last) {
+    throw std::out_of_range("Error: fenwick_tree range is reversed");
+  }
+  return prefix_sum(last) - prefix_sum(first);
+}
+
+template <typename T>
+typename fenwick_tree<T>::size_type fenwick_tree<T>::lower_bound(
+    const value_type& target) const noexcept {
+  if (!(value_type{} < target)) return 0;
+
+  const value_type* tree = tree_.data();
+  size_type count = size();
+  size_type step = 1;
+  while (step <= count / 2) {
+    step <<= 1;
+  }
+
+  size_type pos = 0;
+  value_type remaining = target;
+  for (; step; step >>= 1) {
+    if (pos + step <= count && tree[pos + step] < remaining) {
+      pos += step;
+      remaining -= tree[pos];
+    }
+  }
+  return pos;
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace containers {
+
+// Raw bucket storage for hash_table. Only the buckets in [first_, last_)
+// are constructed, so an incremental rehash can build the new array from
+// the back and tear the old one down from the front a few buckets at a
+// time instead of paying for the whole array in one operation.
+template <typename Bucket>
+class bucket_array {
+ public:
+  using size_type = size_t;
+
+  bucket_array() = default;
+  explicit bucket_array(size_type capacity);
+  bucket_array(const bucket_array& other);
+  bucket_array(bucket_array&& other) noexcept;
+  ~bucket_array();
+
+  bucket_array& operator=(const bucket_array& other);
+  bucket_array& operator=(bucket_array&& other) noexcept;
+
+  Bucket& operator[](size_type pos) noexcept { return data_[pos]; }
+  const Bucket& operator[](size_type pos) const noexcept {
+    return data_[pos];
+  }
+
+  Bucket* begin() const noexcept { return data_; }
+  Bucket* end() const noexcept { return data_ + capacity_; }
+
+  size_type capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return !capacity_; }
+  bool constructed() const noexcept { return last_ == capacity_; }
+  size_type first() const noexcept { return first_; }
+
+  void construct(size_type count) noexcept;
+  void destroy_front() noexcept;
+  void swap(bucket_array& other) noexcept;
+
+ private:
+  Bucket* data_{};
+  size_type capacity_{};
+  size_type first_{};
+  size_type last_{};
+};
+
+template <typename Bucket>
+bucket_array<Bucket>::bucket_array(size_type capacity) {
+  try {
+    data_ = std::allocator<Bucket>().allocate(capacity);
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+  capacity_ = capacity;
+}
+
+template <typename Bucket>
+bucket_array<Bucket>::bucket_array(const bucket_array& other)
+    : bucket_array(other.capacity_) {
+  try {
+    std::uninitialized_copy(other.data_ + other.first_,
+                            other.data_ + other.last_, data_ + other.first_);
+  } catch (...) {
+    std::allocator<Bucket>().deallocate(data_, capacity_);
+    throw;
+  }
+  first_ = other.first_;
+  last_ = other.last_;
+}
+
+template <typename Bucket>
+bucket_array<Bucket>::bucket_array(bucket_array&& other) noexcept {
+  swap(other);
+}
+
+template <typename Bucket>
+bucket_array<Bucket>::~bucket_array() {
+  std::destroy(data_ + first_, data_ + last_);
+  if (data_) {
+    std::allocator<Bucket>().deallocate(data_, capacity_);
+  }
+}
+
+template <typename Bucket>
+bucket_array<Bucket>& bucket_array<Bucket>::operator=(
+    const bucket_array& other) {
+  if (this != &other) {
+    bucket_array copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Bucket>
+bucket_array<Bucket>& bucket_array<Bucket>::operator=(
+    bucket_array&& other) noexcept {
+  bucket_array empty;
+  swap(empty);
+  swap(other);
+  return *this;
+}
+
+template <typename Bucket>
+void bucket_array<Bucket>::construct(size_type count) noexcept {
+  size_type last = last_ + std::min(count, capacity_ - last_);
+  std::uninitialized_value_construct(data_ + last_, data_ + last);
+  last_ = last;
+}
+
+template <typename Bucket>
+void bucket_array<Bucket>::destroy_front() noexcept {
+  std::destroy_at(data_ + first_++);
+}
+
+template <typename Bucket>
+void bucket_array<Bucket>::swap(bucket_array& other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(first_, other.first_);
+  std::swap(last_, other.last_);
+}
+
+}
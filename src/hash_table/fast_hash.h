@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace containers {
+
+namespace hashing {
+
+constexpr uint64_t secret0 = 0xa0761d6478bd642full;
+constexpr uint64_t secret1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t secret2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t secret3 = 0x589965cc75374cc3ull;
+
+inline void multiply(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#else
+  uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xffffffffu,
+           lb = b & 0xffffffffu;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  a = lo;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+  multiply(a, b);
+  return a ^ b;
+}
+
+inline uint64_t read8(const unsigned char* p) noexcept {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t read4(const unsigned char* p) noexcept {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t read3(const unsigned char* p, size_t k) noexcept {
+  return (uint64_t{p[0]} << 16) | (uint64_t{p[k >> 1]} << 8) | p[k - 1];
+}
+
+}  // namespace hashing
+
+inline uint64_t hash_bytes(const void* data, size_t len,
+                           uint64_t seed = 0) noexcept {
+  using namespace hashing;
+  auto p = static_cast<const unsigned char*>(data);
+  uint64_t a, b;
+
+  seed ^= mix(seed ^ secret0, secret1);
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = read3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = mix(read8(p) ^ secret1, read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ secret2, read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ secret3, read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = mix(read8(p) ^ secret1, read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+
+  a ^= secret1;
+  b ^= seed;
+  multiply(a, b);
+  return mix(a ^ secret0 ^ len, b ^ secret1);
+}
+
+inline uint64_t hash_int(uint64_t key) noexcept {
+  using namespace hashing;
+  uint64_t a = key ^ secret0, b = key ^ secret1;
+  multiply(a, b);
+  return mix(a ^ secret0, b ^ secret1);
+}
+
+template <typename K>
+struct fast_hash {
+  size_t operator()(const K& key) const noexcept {
+    if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+      return hash_int(static_cast<uint64_t>(key));
+    } else if constexpr (std::is_pointer_v<K>) {
+      return hash_int(reinterpret_cast<uintptr_t>(key));
+    } else if constexpr (std::is_floating_point_v<K>) {
+      return key == K{} ? hash_int(0) : hash_bytes(&key, sizeof(key));
+    } else {
+      return hash_int(std::hash<K>{}(key));
+    }
+  }
+};
+
+template <typename CharT, typename Traits>
+struct fast_hash<std::basic_string_view<CharT, Traits>> {
+  size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept {
+    return hash_bytes(key.data(), key.size() * sizeof(CharT));
+  }
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct fast_hash<std::basic_string<CharT, Traits, Alloc>> {
+  size_t operator()(
+      const std::basic_string<CharT, Traits, Alloc>& key) const noexcept {
+    return hash_bytes(key.data(), key.size() * sizeof(CharT));
+  }
+};
+
+}
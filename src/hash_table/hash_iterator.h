@@ -1,7 +1,6 @@
 #pragma once
 
 #include "list.h"
-#include "vector.h"
 
 namespace containers {
 
@@ -11,7 +10,8 @@ class hash_table;
 template <typename K, typename V>
 class base_hash_iterator {
  public:
-  friend class hash_table<K, V, std::hash<K>>;
+  template <typename, typename, typename>
+  friend class hash_table;
   using key_type = K;
   using mapped_type = std::remove_const_t<V>;
   using value_type = std::pair<key_type, mapped_type>;
@@ -19,7 +19,7 @@ class base_hash_iterator {
   using pointer = value_type*;
   using iterator_category = std::forward_iterator_tag;
   using bucket = List<value_type>;
-  using table_it = typename Vector<bucket>::iterator;
+  using table_it = bucket*;
   using bucket_it = typename bucket::iterator;
 
   base_hash_iterator(const base_hash_iterator& other) = default;
@@ -35,42 +35,61 @@ class base_hash_iterator {
 
  protected:
   base_hash_iterator(table_it begin, table_it end, bucket_it b)
-      : begin_(begin), end_(end), b_(b) {}
+      : begin_(begin), end_(end), next_(end), last_(end), b_(b) {}
+  base_hash_iterator(table_it begin, table_it end, table_it next,
+                     table_it last, bucket_it b)
+      : begin_(begin), end_(end), next_(next), last_(last), b_(b) {}
 
   void advance() {
     if (begin_ == end_) {
       throw std::out_of_range("Error: attempt to access beyond map");
     }
 
+    ++b_;
     if (b_ != begin_->end()) {
-      ++b_;
       return;
     }
     ++begin_;
-    while (begin_ != end_) {
-      if (!(begin_->empty())) {
-        b_ = begin_->begin();
+    seek();
+  }
+
+  // Moves to the first element at or after begin_. An iterator into the
+  // old buckets of an unfinished rehash continues into [next_, last_).
+  void seek() {
+    while (true) {
+      for (; begin_ != end_; ++begin_) {
+        if (!begin_->empty()) {
+          b_ = begin_->begin();
+          return;
+        }
+      }
+      if (end_ == last_) {
         return;
       }
-      ++begin_;
+      begin_ = next_;
+      end_ = last_;
     }
   }
 
   bool equals(const base_hash_iterator& other) const {
-    if (begin_ == other.begin_ && end_ == other.end_) return true;
+    if (begin_ != other.begin_) return false;
+    if (begin_ == end_) return true;
 
     return b_ == other.b_;
   }
 
   table_it begin_;
   table_it end_;
+  table_it next_;
+  table_it last_;
   bucket_it b_;
 };
 
 template <typename K, typename V>
 class hash_iterator : public base_hash_iterator<K, V> {
  public:
-  friend class hash_table<K, V, std::hash<K>>;
+  template <typename, typename, typename>
+  friend class hash_table;
   using base = base_hash_iterator<K, V>;
   using key_type = typename base::key_type;
   using mapped_type = typename base::mapped_type;
@@ -111,7 +130,8 @@ class hash_iterator : public base_hash_iterator<K, V> {
 template <typename K, typename V>
 class const_hash_iterator : public base_hash_iterator<K, const V> {
  public:
-  friend class hash_table<K, V, std::hash<K>>;
+  template <typename, typename, typename>
+  friend class hash_table;
   using base = base_hash_iterator<K, const V>;
   using key_type = typename base::key_type;
   using mapped_type = typename base::mapped_type;
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
+
+#include "bucket_array.h"
 #include "list.h"
 #include "vector.h"
 #include "hash_iterator.h"
+#include "fast_hash.h"
+#include "instrument.h"
 
 namespace containers {
 
-template <typename K, typename V, typename H = std::hash<K>>
+template <typename K, typename V, typename H = fast_hash<K>>
 class hash_table {
  public:
   using key_type = K;
@@ -19,18 +24,30 @@ class hash_table {
   using const_iterator = const_hash_iterator<key_type, mapped_type>;
   using size_type = size_t;
 
-  hash_table() : table_(defualt_capacity) {}
+  hash_table() = default;
   hash_table(const hash_table& other) = default;
   hash_table(hash_table&& other) = default;
   ~hash_table() = default;
 
-  hash_table<K, V>& operator=(const hash_table& other) = default;
-  hash_table<K, V>& operator=(hash_table&& other) = default;
+  hash_table& operator=(const hash_table& other) = default;
+  hash_table& operator=(hash_table&& other) = default;
 
   size_type size() const noexcept;
   size_type capacity() const noexcept;
   bool empty() const noexcept;
   void clear();
+  void shrink_to_fit();
+  void rehash(size_type buckets);
+
+  // Erasing below this load shrinks the table to max_load_factor / 2, which
+  // invalidates iterators. Off (0) by default so erasing while iterating is
+  // safe. Clamped to [0, max_load_factor / 4] to keep a gap between the
+  // shrink trigger and the load right after a shrink.
+  void set_min_load_factor(double factor) noexcept;
+  double min_load_factor() const noexcept;
+  void set_incremental_rehash(bool enabled) noexcept;
+  bool incremental_rehash() const noexcept;
+  bool rehashing() const noexcept;
 
   iterator begin();
   iterator end();
@@ -43,11 +60,12 @@ class hash_table {
   mapped_type& operator[](const key_type& key);
 
   void erase(iterator pos);
+  iterator replace_key(iterator pos, const key_type& key);
   void swap(hash_table& other);
   void assign(value_type& value);
 
   template <typename... Args>
-  s21::Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
   std::pair<iterator, bool> insert(const value_type& value);
   std::pair<iterator, bool> insert(const key_type& key,
                                    const mapped_type& value);
@@ -61,12 +79,31 @@ class hash_table {
   int compute_hash(const key_type& key) const noexcept {
     return hash_function(key);
   }
-  void resize() { table_.reserve(table_.capacity()); }
-  bool exceeds_limit(double load_limit = 0.7) {
-    load_factor = (double)size() / capacity();
-    return std::abs(load_factor - load_limit) >
-           std::numeric_limits<double>::epsilon();
+  void resize(size_type buckets);
+  void migrate(size_type buckets);
+  void finish_rehash();
+  static size_type buckets_for(size_type count, double load) {
+    return std::max<size_type>(defualt_capacity,
+                               static_cast<size_type>(count / load) + 1);
+  }
+  void allocate_table() {
+    if (table_.empty()) {
+      bucket_array<bucket> table(defualt_capacity);
+      table.construct(defualt_capacity);
+      table_.swap(table);
+    }
+  }
+  bool exceeds_limit(double load_limit = max_load_factor) {
+    load_factor = (double)(size() + 1) / capacity();
+    return load_factor > load_limit;
   }
+  bucket_array<bucket>& locate(const key_type& key, int& hash);
+  const bucket_array<bucket>& locate(const key_type& key, int& hash) const;
+  iterator make_iterator(bucket_array<bucket>& table, int hash,
+                         typename bucket::iterator it);
+  template <typename Iterator>
+  Iterator first_element() const;
+  typename bucket::iterator last_bucket_end() const;
 
  private:
   int hash_function(const key_type& key) const noexcept {
@@ -74,9 +111,15 @@ class hash_table {
   }
 
   constexpr static int defualt_capacity = 10;
+  constexpr static size_type rehash_step = 4;
+  constexpr static size_type construct_ratio = 4;
+  constexpr static double max_load_factor = 0.7;
   size_type size_{};
   double load_factor{};
-  Vector<bucket> table_;
+  double min_load_factor_{};
+  bucket_array<bucket> table_;
+  bucket_array<bucket> old_table_;
+  bool incremental_{false};
 };
 
 template <typename K, typename V, typename H>
@@ -96,15 +139,202 @@ bool hash_table<K, V, H>::empty() const noexcept {
   return !size();
 }
 
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::set_min_load_factor(double factor) noexcept {
+  min_load_factor_ = std::clamp(factor, 0.0, max_load_factor / 4);
+}
+
+template <typename K, typename V, typename H>
+double hash_table<K, V, H>::min_load_factor() const noexcept {
+  return min_load_factor_;
+}
+
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::set_incremental_rehash(bool enabled) noexcept {
+  incremental_ = enabled;
+}
+
+template <typename K, typename V, typename H>
+bool hash_table<K, V, H>::incremental_rehash() const noexcept {
+  return incremental_;
+}
+
+template <typename K, typename V, typename H>
+bool hash_table<K, V, H>::rehashing() const noexcept {
+  return !old_table_.empty();
+}
+
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::resize(size_type buckets) {
+  CONTAINERS_MEASURE(rehash);
+  finish_rehash();
+
+  bucket_array<bucket> table(buckets);
+  old_table_.swap(table_);
+  table_.swap(table);
+
+  if (!incremental_) {
+    finish_rehash();
+  }
+}
+
+// One step of an incremental rehash. The new buckets are constructed
+// construct_ratio times faster than the old ones are drained, so a doubling
+// finishes well before the next one is due. Nodes are relinked into their
+// new bucket, and each drained old bucket is destroyed straight away.
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::migrate(size_type buckets) {
+  if (!rehashing()) {
+    return;
+  }
+  if (!table_.constructed()) {
+    table_.construct(buckets * construct_ratio);
+    return;
+  }
+
+  for (; buckets && old_table_.first() < old_table_.capacity(); --buckets) {
+    auto& bucket = old_table_[old_table_.first()];
+    while (!bucket.empty()) {
+      auto node = bucket.begin();
+      auto& target = table_[compute_hash(node->first)];
+      target.splice(target.cend(), bucket, node);
+    }
+    old_table_.destroy_front();
+  }
+
+  if (old_table_.first() == old_table_.capacity()) {
+    bucket_array<bucket> empty;
+    old_table_.swap(empty);
+  }
+}
+
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::finish_rehash() {
+  table_.construct(table_.capacity());
+  migrate(old_table_.capacity());
+}
+
+template <typename K, typename V, typename H>
+bucket_array<typename hash_table<K, V, H>::bucket>&
+hash_table<K, V, H>::locate(const key_type& key, int& hash) {
+  if (rehashing()) {
+    size_type old = H()(key) % old_table_.capacity();
+    if (old >= old_table_.first()) {
+      hash = old;
+      return old_table_;
+    }
+  }
+  hash = compute_hash(key);
+  return table_;
+}
+
+template <typename K, typename V, typename H>
+const bucket_array<typename hash_table<K, V, H>::bucket>&
+hash_table<K, V, H>::locate(const key_type& key, int& hash) const {
+  if (rehashing()) {
+    size_type old = H()(key) % old_table_.capacity();
+    if (old >= old_table_.first()) {
+      hash = old;
+      return old_table_;
+    }
+  }
+  hash = compute_hash(key);
+  return table_;
+}
+
+template <typename K, typename V, typename H>
+typename hash_table<K, V, H>::iterator hash_table<K, V, H>::make_iterator(
+    bucket_array<bucket>& table, int hash, typename bucket::iterator it) {
+  if (&table == &old_table_) {
+    auto next = table_.constructed() ? table_.begin() : table_.end();
+    return iterator{old_table_.begin() + hash, old_table_.end(), next,
+                    table_.end(), it};
+  }
+  return iterator{table_.begin() + hash, table_.end(), it};
+}
+
+template <typename K, typename V, typename H>
+template <typename Iterator>
+Iterator hash_table<K, V, H>::first_element() const {
+  auto last = table_.end();
+  auto next = table_.constructed() ? table_.begin() : last;
+  Iterator it = rehashing()
+                    ? Iterator{old_table_.begin() + old_table_.first(),
+                               old_table_.end(), next, last,
+                               typename bucket::iterator{}}
+                    : Iterator{next, last, typename bucket::iterator{}};
+  it.seek();
+  return it;
+}
+
+template <typename K, typename V, typename H>
+typename hash_table<K, V, H>::bucket::iterator
+hash_table<K, V, H>::last_bucket_end() const {
+  if (table_.constructed()) {
+    for (auto it = table_.end(); it != table_.begin();) {
+      --it;
+      if (!it->empty()) {
+        return it->end();
+      }
+    }
+  }
+  if (rehashing()) {
+    auto first = old_table_.begin() + old_table_.first();
+    for (auto it = old_table_.end(); it != first;) {
+      --it;
+      if (!it->empty()) {
+        return it->end();
+      }
+    }
+  }
+
+  return typename bucket::iterator{};
+}
+
 template <typename K, typename V, typename H>
 void hash_table<K, V, H>::clear() {
-  table_.clear();
+  bucket_array<bucket> table;
+  bucket_array<bucket> old_table;
+  table_.swap(table);
+  old_table_.swap(old_table);
+  size_ = 0;
+}
+
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::shrink_to_fit() {
+  if (empty()) {
+    clear();
+    return;
+  }
+
+  size_type buckets = buckets_for(size_, max_load_factor);
+  if (buckets < capacity()) {
+    resize(buckets);
+  }
+  finish_rehash();
+}
+
+template <typename K, typename V, typename H>
+void hash_table<K, V, H>::rehash(size_type buckets) {
+  if (empty() && !buckets) {
+    clear();
+    return;
+  }
+
+  buckets = std::max(buckets, buckets_for(size_, max_load_factor));
+  if (buckets != capacity()) {
+    resize(buckets);
+  }
+  finish_rehash();
 }
 
 template <typename K, typename V, typename H>
 bool hash_table<K, V, H>::contains(const key_type& key) const noexcept {
-  int hash = compute_hash(key);
-  auto& bucket = table_[hash];
+  if (table_.empty()) {
+    return false;
+  }
+  int hash;
+  auto& bucket = locate(key, hash)[hash];
 
   for (auto& it : bucket) {
     if (it.first == key) {
@@ -118,12 +348,17 @@ bool hash_table<K, V, H>::contains(const key_type& key) const noexcept {
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::iterator hash_table<K, V, H>::find(
     const key_type& key) {
-  int hash = compute_hash(key);
-  auto& bucket = table_[hash];
+  CONTAINERS_MEASURE(find);
+  if (table_.empty()) {
+    return end();
+  }
+  int hash;
+  auto& table = locate(key, hash);
+  auto& bucket = table[hash];
 
   for (auto it = bucket.begin(); it != bucket.end(); ++it) {
     if (it->first == key) {
-      return iterator{table_.begin() + hash, table_.end(), it};
+      return make_iterator(table, hash, it);
     }
   }
 
@@ -132,79 +367,43 @@ typename hash_table<K, V, H>::iterator hash_table<K, V, H>::find(
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::iterator hash_table<K, V, H>::begin() {
-  for (auto it = table_.begin(); it != table_.end(); ++it) {
-    if (!it->empty()) {
-      return iterator{it, table_.end(), it->begin()};
-    }
-  }
-
-  return end();
+  return first_element<iterator>();
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::iterator hash_table<K, V, H>::end() {
-  auto it = table_.end() - 1;
-  for (; it >= table_.begin(); --it) {
-    if (!it->empty()) {
-      return iterator{table_.end(), table_.end(), it->end()};
-    }
-  }
-
-  return iterator{table_.end(), table_.end(), it->end()};
+  return iterator{table_.end(), table_.end(), last_bucket_end()};
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::const_iterator hash_table<K, V, H>::begin()
     const {
-  for (auto it = table_.begin(); it != table_.end(); ++it) {
-    if (!it->empty()) {
-      return const_iterator{it, table_.end(), it->begin()};
-    }
-  }
-
-  return end();
+  return first_element<const_iterator>();
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::const_iterator hash_table<K, V, H>::end() const {
-  auto it = table_.end() - 1;
-  for (; it >= table_.begin(); --it) {
-    if (!it->empty()) {
-      return const_iterator{table_.end(), table_.end(), it->end()};
-    }
-  }
-
-  return const_iterator{table_.end(), table_.end(), it->end()};
+  return const_iterator{table_.end(), table_.end(), last_bucket_end()};
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::const_iterator hash_table<K, V, H>::cbegin()
     const {
-  for (auto it = table_.begin(); it != table_.end(); ++it) {
-    if (!it->empty()) {
-      return const_iterator{it, table_.end(), it->begin()};
-    }
-  }
-
-  return end();
+  return begin();
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::const_iterator hash_table<K, V, H>::cend() const {
-  auto it = table_.end() - 1;
-  for (; it >= table_.begin(); --it) {
-    if (!it->empty()) {
-      return const_iterator{table_.end(), table_.end(), it->end()};
-    }
-  }
-
-  return const_iterator{table_.end(), table_.end(), it->end()};
+  return end();
 }
 
 template <typename K, typename V, typename H>
 void hash_table<K, V, H>::assign(value_type& value) {
-  int hash = compute_hash(value.first);
-  auto& bucket = table_[hash];
+  if (table_.empty()) {
+    return;
+  }
+  int hash;
+  auto& bucket = locate(value.first, hash)[hash];
 
   for (auto& it : bucket) {
     if (it.first == value.first) {
@@ -216,7 +415,7 @@ void hash_table<K, V, H>::assign(value_type& value) {
 
 template <typename K, typename V, typename H>
 template <typename... Args>
-s21::Vector<std::pair<typename hash_table<K, V, H>::iterator, bool>>
+Vector<std::pair<typename hash_table<K, V, H>::iterator, bool>>
 hash_table<K, V, H>::insert_many(Args&&... args) {
   return {insert(std::forward<Args>(args))...};
 }
@@ -224,24 +423,29 @@ hash_table<K, V, H>::insert_many(Args&&... args) {
 template <typename K, typename V, typename H>
 std::pair<typename hash_table<K, V, H>::iterator, bool>
 hash_table<K, V, H>::insert(const value_type& value) {
-  if (exceeds_limit()) {
-    resize();
-  }
-
-  int hash = compute_hash(value.first);
-  auto& bucket = table_[hash];
-  for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+  CONTAINERS_MEASURE(insert);
+  allocate_table();
+  migrate(rehash_step);
+
+  int hash;
+  auto* table = &locate(value.first, hash);
+  auto* bucket = &(*table)[hash];
+  for (auto it = bucket->begin(); it != bucket->end(); ++it) {
     if (it->first == value.first) {
-      return std::make_pair(iterator(table_.begin() + hash, table_.end(), it),
-                            false);
+      return std::make_pair(make_iterator(*table, hash, it), false);
     }
   }
 
-  bucket.push_back(value);
+  if (exceeds_limit()) {
+    resize(capacity() * 2);
+    table = &locate(value.first, hash);
+    bucket = &(*table)[hash];
+  }
+  bucket->push_back(value);
   ++size_;
 
-  return std::make_pair(
-      iterator(table_.begin() + hash, table_.end(), bucket.end()), true);
+  auto last = bucket->end();
+  return std::make_pair(make_iterator(*table, hash, --last), true);
 }
 
 template <typename K, typename V, typename H>
@@ -268,46 +472,91 @@ hash_table<K, V, H>::insert_or_assign(const key_type& key,
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::mapped_type& hash_table<K, V, H>::operator[](
     const key_type& key) {
-  int hash = compute_hash(key);
-  auto& bucket = table_[hash];
+  CONTAINERS_MEASURE(insert);
+  allocate_table();
+  migrate(rehash_step);
 
-  for (auto& it : bucket) {
+  int hash;
+  auto* bucket = &locate(key, hash)[hash];
+  for (auto& it : *bucket) {
     if (it.first == key) {
       return it.second;
     }
   }
+
   if (exceeds_limit()) {
-    resize();
+    resize(capacity() * 2);
+    bucket = &locate(key, hash)[hash];
   }
-  bucket.push_back(std::make_pair(key, mapped_type{}));
+  bucket->push_back(std::make_pair(key, mapped_type{}));
   ++size_;
 
-  return bucket.end()->second;
+  return bucket->end()->second;
 }
 
 template <typename K, typename V, typename H>
 typename hash_table<K, V, H>::mapped_type& hash_table<K, V, H>::at(
     const key_type& key) {
-  if (!contains(key)) {
+  iterator it = find(key);
+  if (it == end()) {
     throw std::out_of_range("Error: key doesn't exist");
   }
 
-  return (*this)[key];
+  return it->second;
 }
 
 template <typename K, typename V, typename H>
 void hash_table<K, V, H>::swap(hash_table& other) {
   table_.swap(other.table_);
+  old_table_.swap(other.old_table_);
+  std::swap(size_, other.size_);
+  std::swap(min_load_factor_, other.min_load_factor_);
+  std::swap(incremental_, other.incremental_);
 }
 
 template <typename K, typename V, typename H>
 void hash_table<K, V, H>::erase(iterator pos) {
-  int hash = pos->first;
-  auto& bucket = table_[hash];
+  CONTAINERS_MEASURE(erase);
+  int hash;
+  auto& bucket = locate(pos->first, hash)[hash];
 
   typename bucket::iterator b = pos.get_bucket_it();
   bucket.erase(b);
   --size_;
+  if (min_load_factor_ <= 0) {
+    return;
+  }
+
+  // Shrinking already gives up iterator stability, so erase may also move a
+  // pending migration along. The shrink itself runs to completion: the
+  // erase-only workloads that trigger it would never finish an incremental
+  // one.
+  migrate(rehash_step);
+  if (rehashing() || capacity() <= defualt_capacity ||
+      (double)size_ / capacity() >= min_load_factor_) {
+    return;
+  }
+  size_type buckets = buckets_for(size_, max_load_factor / 2);
+  if (buckets < capacity()) {
+    resize(buckets);
+    finish_rehash();
+  }
+}
+
+// Moves the entry at pos under a key that is not in the table yet. The
+// list node is relinked into its new bucket rather than reallocated.
+template <typename K, typename V, typename H>
+typename hash_table<K, V, H>::iterator hash_table<K, V, H>::replace_key(
+    iterator pos, const key_type& key) {
+  int hash;
+  auto& from = locate(pos->first, hash)[hash];
+  auto& table = locate(key, hash);
+  auto& to = table[hash];
+
+  typename bucket::iterator node = pos.get_bucket_it();
+  node->first = key;
+  to.splice(to.cend(), from, node);
+  return make_iterator(table, hash, node);
 }
 
 }
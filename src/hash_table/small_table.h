@@ -0,0 +1,264 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+
+#include "hash_table.h"
+#include "small_table_iterator.h"
+
+namespace containers {
+
+constexpr size_t default_small_size = 8;
+
+template <typename K, typename V, typename H = fast_hash<K>,
+          size_t N = default_small_size>
+class small_table {
+ public:
+  using table = hash_table<K, V, H>;
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = small_table_iterator<value_type, typename table::iterator>;
+  using size_type = size_t;
+
+  static constexpr size_type small_size = N;
+
+  small_table() = default;
+  small_table(const small_table& other) = default;
+  small_table(small_table&& other) = default;
+  ~small_table() = default;
+
+  small_table& operator=(const small_table& other) = default;
+  small_table& operator=(small_table&& other) = default;
+
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+  bool is_small() const noexcept;
+  void clear();
+  void shrink_to_fit();
+  void set_min_load_factor(double factor) noexcept;
+  void set_incremental_rehash(bool enabled) noexcept;
+
+  iterator begin();
+  iterator end();
+
+  mapped_type& at(const key_type& key);
+  mapped_type& operator[](const key_type& key);
+
+  void erase(iterator pos);
+  void swap(small_table& other);
+
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const key_type& key,
+                                   const mapped_type& value);
+  std::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                             const mapped_type& value);
+
+  iterator find(const key_type& key);
+  bool contains(const key_type& key) const noexcept;
+
+ private:
+  size_type scan(const key_type& key) const noexcept {
+    for (size_type i = 0; i < inline_size_; ++i) {
+      if (inline_[i].first == key) return i;
+    }
+    return inline_size_;
+  }
+  void spill();
+
+  std::array<value_type, N> inline_{};
+  size_type inline_size_{0};
+  bool spilled_{N == 0};
+  table table_;
+};
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::size_type small_table<K, V, H, N>::size()
+    const noexcept {
+  return spilled_ ? table_.size() : inline_size_;
+}
+
+template <typename K, typename V, typename H, size_t N>
+bool small_table<K, V, H, N>::empty() const noexcept {
+  return !size();
+}
+
+template <typename K, typename V, typename H, size_t N>
+bool small_table<K, V, H, N>::is_small() const noexcept {
+  return !spilled_;
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::clear() {
+  for (size_type i = 0; i < inline_size_; ++i) {
+    inline_[i] = value_type{};
+  }
+  inline_size_ = 0;
+  spilled_ = N == 0;
+
+  table tmp;
+  tmp.set_incremental_rehash(table_.incremental_rehash());
+  tmp.set_min_load_factor(table_.min_load_factor());
+  table_.swap(tmp);
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::shrink_to_fit() {
+  if (!spilled_ || N == 0 || table_.size() > N) {
+    table_.shrink_to_fit();
+    return;
+  }
+
+  size_type count = 0;
+  for (auto& it : table_) {
+    inline_[count++] = it;
+  }
+  table_.clear();
+  inline_size_ = count;
+  spilled_ = false;
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::set_min_load_factor(double factor) noexcept {
+  table_.set_min_load_factor(factor);
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::set_incremental_rehash(bool enabled) noexcept {
+  table_.set_incremental_rehash(enabled);
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::spill() {
+  for (size_type i = 0; i < inline_size_; ++i) {
+    table_.insert(inline_[i]);
+    inline_[i] = value_type{};
+  }
+  inline_size_ = 0;
+  spilled_ = true;
+}
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::iterator small_table<K, V, H, N>::begin() {
+  if (spilled_) return iterator(table_.begin());
+  return iterator(inline_.data(), 0);
+}
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::iterator small_table<K, V, H, N>::end() {
+  if (spilled_) return iterator(table_.end());
+  return iterator(inline_.data(), inline_size_);
+}
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::iterator small_table<K, V, H, N>::find(
+    const key_type& key) {
+  CONTAINERS_MEASURE(find);
+  if (spilled_) return iterator(table_.find(key));
+  return iterator(inline_.data(), scan(key));
+}
+
+template <typename K, typename V, typename H, size_t N>
+bool small_table<K, V, H, N>::contains(const key_type& key) const noexcept {
+  if (spilled_) return table_.contains(key);
+  return scan(key) != inline_size_;
+}
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::mapped_type& small_table<K, V, H, N>::at(
+    const key_type& key) {
+  if (spilled_) return table_.at(key);
+
+  size_type pos = scan(key);
+  if (pos == inline_size_) {
+    throw std::out_of_range("Error: key doesn't exist");
+  }
+  return inline_[pos].second;
+}
+
+template <typename K, typename V, typename H, size_t N>
+typename small_table<K, V, H, N>::mapped_type&
+small_table<K, V, H, N>::operator[](const key_type& key) {
+  CONTAINERS_MEASURE(insert);
+  if (!spilled_) {
+    size_type pos = scan(key);
+    if (pos < inline_size_) return inline_[pos].second;
+    if (inline_size_ < N) {
+      inline_[inline_size_] = value_type{key, mapped_type{}};
+      return inline_[inline_size_++].second;
+    }
+    spill();
+  }
+  return table_[key];
+}
+
+template <typename K, typename V, typename H, size_t N>
+std::pair<typename small_table<K, V, H, N>::iterator, bool>
+small_table<K, V, H, N>::insert(const value_type& value) {
+  CONTAINERS_MEASURE(insert);
+  if (!spilled_) {
+    size_type pos = scan(value.first);
+    if (pos < inline_size_) {
+      return std::make_pair(iterator(inline_.data(), pos), false);
+    }
+    if (inline_size_ < N) {
+      inline_[inline_size_] = value;
+      return std::make_pair(iterator(inline_.data(), inline_size_++), true);
+    }
+    spill();
+  }
+  auto result = table_.insert(value);
+  return std::make_pair(iterator(result.first), result.second);
+}
+
+template <typename K, typename V, typename H, size_t N>
+std::pair<typename small_table<K, V, H, N>::iterator, bool>
+small_table<K, V, H, N>::insert(const key_type& key, const mapped_type& value) {
+  return insert(std::make_pair(key, value));
+}
+
+template <typename K, typename V, typename H, size_t N>
+std::pair<typename small_table<K, V, H, N>::iterator, bool>
+small_table<K, V, H, N>::insert_or_assign(const key_type& key,
+                                          const mapped_type& value) {
+  std::pair<iterator, bool> it = insert(key, value);
+  if (!it.second) {
+    it.first->second = value;
+  }
+  return it;
+}
+
+template <typename K, typename V, typename H, size_t N>
+template <typename... Args>
+Vector<std::pair<typename small_table<K, V, H, N>::iterator, bool>>
+small_table<K, V, H, N>::insert_many(Args&&... args) {
+  return {insert(std::forward<Args>(args))...};
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::erase(iterator pos) {
+  CONTAINERS_MEASURE(erase);
+  if (spilled_) {
+    table_.erase(*pos.table_it_);
+    return;
+  }
+
+  for (size_type i = pos.index_; i + 1 < inline_size_; ++i) {
+    inline_[i] = std::move(inline_[i + 1]);
+  }
+  inline_[--inline_size_] = value_type{};
+}
+
+template <typename K, typename V, typename H, size_t N>
+void small_table<K, V, H, N>::swap(small_table& other) {
+  std::swap(inline_, other.inline_);
+  std::swap(inline_size_, other.inline_size_);
+  std::swap(spilled_, other.spilled_);
+  table_.swap(other.table_);
+}
+
+}
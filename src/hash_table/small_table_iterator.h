@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace containers {
+
+template <typename, typename, typename, size_t>
+class small_table;
+
+template <typename Value, typename TableIterator>
+class small_table_iterator {
+ public:
+  using value_type = Value;
+  using reference = value_type&;
+  using pointer = value_type*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  small_table_iterator() = default;
+
+  reference operator*() { return table_it_ ? **table_it_ : inline_[index_]; }
+  pointer operator->() { return &**this; }
+
+  small_table_iterator& operator++() {
+    if (table_it_) {
+      ++*table_it_;
+    } else {
+      ++index_;
+    }
+    return *this;
+  }
+  small_table_iterator operator++(int) {
+    auto tmp{*this};
+    ++*this;
+    return tmp;
+  }
+
+  friend bool operator==(const small_table_iterator& a,
+                         const small_table_iterator& b) {
+    if (a.table_it_ && b.table_it_) return *a.table_it_ == *b.table_it_;
+    if (a.table_it_ || b.table_it_) return false;
+    return a.inline_ == b.inline_ && a.index_ == b.index_;
+  }
+  friend bool operator!=(const small_table_iterator& a,
+                         const small_table_iterator& b) {
+    return !(a == b);
+  }
+
+ private:
+  template <typename, typename, typename, size_t>
+  friend class small_table;
+
+  small_table_iterator(pointer inline_storage, size_t index)
+      : inline_(inline_storage), index_(index) {}
+  explicit small_table_iterator(TableIterator it) : table_it_(std::move(it)) {}
+
+  pointer inline_{};
+  size_t index_{};
+  std::optional<TableIterator> table_it_;
+};
+
+}
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "dense_int_map.h"
+#include "fast_hash.h"
+#include "vector.h"
+
+namespace containers {
+
+namespace hll {
+
+constexpr uint8_t min_precision = 4;
+constexpr uint8_t max_precision = 18;
+constexpr uint8_t default_precision = 14;
+constexpr uint8_t format_version = 1;
+constexpr uint8_t sparse_format = 0;
+constexpr uint8_t dense_format = 1;
+constexpr size_t header_size = 3;
+constexpr size_t sparse_entry_size = 5;
+constexpr size_t simd_width = 16;
+
+struct register_sum {
+  double sum;
+  size_t zeros;
+};
+
+inline void merge_registers(uint8_t* dst, const uint8_t* src, size_t count) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + simd_width <= count; i += simd_width) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = std::max(dst[i], src[i]);
+  }
+}
+
+inline register_sum sum_registers(const uint8_t* registers, size_t count) {
+  register_sum result{0.0, 0};
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bias = _mm_set1_epi32(127);
+  for (; i + simd_width <= count; i += simd_width) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(registers + i));
+    result.zeros += __builtin_popcount(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+
+    __m128i lo = _mm_unpacklo_epi8(block, zero);
+    __m128i hi = _mm_unpackhi_epi8(block, zero);
+    __m128i parts[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+
+    // 2^-r is built directly as the float with biased exponent 127 - r.
+    __m128 acc = _mm_setzero_ps();
+    for (auto& part : parts) {
+      __m128i exponent = _mm_slli_epi32(_mm_sub_epi32(bias, part), 23);
+      acc = _mm_add_ps(acc, _mm_castsi128_ps(exponent));
+    }
+    alignas(simd_width) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    result.sum += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] +
+                  lanes[3];
+  }
+#endif
+  for (; i < count; ++i) {
+    result.sum += std::ldexp(1.0, -registers[i]);
+    result.zeros += !registers[i];
+  }
+  return result;
+}
+
+inline double alpha(size_t registers) noexcept {
+  switch (registers) {
+    case 16:
+      return 0.673;
+    case 32:
+      return 0.697;
+    case 64:
+      return 0.709;
+    default:
+      return 0.7213 / (1.0 + 1.079 / static_cast<double>(registers));
+  }
+}
+
+}
+
+template <typename K, typename H = fast_hash<K>>
+class hyperloglog {
+ public:
+  using key_type = K;
+  using hasher = H;
+  using size_type = size_t;
+
+  explicit hyperloglog(uint8_t precision = hll::default_precision);
+  hyperloglog(const hyperloglog& other);
+  hyperloglog(hyperloglog&& other) noexcept;
+  ~hyperloglog() = default;
+
+  hyperloglog& operator=(const hyperloglog& other);
+  hyperloglog& operator=(hyperloglog&& other) noexcept;
+
+  uint8_t precision() const noexcept { return precision_; }
+  size_type register_count() const noexcept {
+    return size_type{1} << precision_;
+  }
+  bool is_sparse() const noexcept { return !registers_; }
+  size_type bytes() const noexcept;
+  bool empty() const noexcept;
+  void clear();
+
+  void insert(const key_type& key) { insert_hash(hasher{}(key)); }
+  void insert_hash(uint64_t hash);
+  template <typename... Args>
+  void insert_many(Args&&... args) {
+    (insert(std::forward<Args>(args)), ...);
+  }
+
+  void merge(const hyperloglog& other);
+  void swap(hyperloglog& other) noexcept;
+
+  double estimate() const;
+  size_type count() const {
+    return static_cast<size_type>(std::llround(estimate()));
+  }
+
+  Vector<uint8_t> serialize() const;
+  static hyperloglog deserialize(const uint8_t* data, size_type size);
+  static hyperloglog deserialize(const Vector<uint8_t>& data) {
+    return deserialize(data.data(), data.size());
+  }
+
+ private:
+  using sparse_map = dense_int_map<uint32_t, uint8_t>;
+
+  // A sparse table of m/32 entries needs at most m/16 slots of 5 bytes,
+  // so the sparse form always stays below half of the m dense bytes.
+  size_type sparse_limit() const noexcept { return register_count() / 32; }
+  uint8_t max_rank() const noexcept { return 65 - precision_; }
+  void update(uint32_t index, uint8_t rank);
+  void densify();
+
+  uint8_t precision_;
+  sparse_map sparse_;
+  std::unique_ptr<uint8_t[]> registers_;
+};
+
+template <typename K, typename H>
+hyperloglog<K, H>::hyperloglog(uint8_t precision) : precision_(precision) {
+  if (precision < hll::min_precision || precision > hll::max_precision) {
+    throw std::out_of_range("Error: hyperloglog precision out of range");
+  }
+}
+
+template <typename K, typename H>
+hyperloglog<K, H>::hyperloglog(const hyperloglog& other)
+    : precision_(other.precision_), sparse_(other.sparse_) {
+  if (other.registers_) {
+    registers_ = std::make_unique<uint8_t[]>(register_count());
+    std::copy_n(other.registers_.get(), register_count(), registers_.get());
+  }
+}
+
+template <typename K, typename H>
+hyperloglog<K, H>::hyperloglog(hyperloglog&& other) noexcept
+    : precision_(other.precision_),
+      sparse_(std::move(other.sparse_)),
+      registers_(std::move(other.registers_)) {}
+
+template <typename K, typename H>
+hyperloglog<K, H>& hyperloglog<K, H>::operator=(const hyperloglog& other) {
+  if (this != &other) {
+    hyperloglog tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename H>
+hyperloglog<K, H>& hyperloglog<K, H>::operator=(hyperloglog&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename K, typename H>
+bool hyperloglog<K, H>::empty() const noexcept {
+  if (is_sparse()) return sparse_.empty();
+  return hll::sum_registers(registers_.get(), register_count()).zeros ==
+         register_count();
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::clear() {
+  sparse_map tmp;
+  sparse_.swap(tmp);
+  registers_.reset();
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::insert_hash(uint64_t hash) {
+  uint32_t index = static_cast<uint32_t>(hash >> (64 - precision_));
+  uint64_t rest = (hash << precision_) | (uint64_t{1} << (precision_ - 1));
+  update(index, static_cast<uint8_t>(__builtin_clzll(rest) + 1));
+}
+
+template <typename K, typename H>
+typename hyperloglog<K, H>::size_type hyperloglog<K, H>::bytes()
+    const noexcept {
+  if (registers_) return register_count();
+  return sparse_.capacity() * (sizeof(uint32_t) + sizeof(uint8_t));
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::update(uint32_t index, uint8_t rank) {
+  if (registers_) {
+    registers_[index] = std::max(registers_[index], rank);
+    return;
+  }
+
+  uint8_t& current = sparse_[index];
+  current = std::max(current, rank);
+  if (sparse_.size() > sparse_limit()) {
+    densify();
+  }
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::densify() {
+  registers_ = std::make_unique<uint8_t[]>(register_count());
+  for (auto it : sparse_) {
+    registers_[it.first] = it.second;
+  }
+  sparse_map tmp;
+  sparse_.swap(tmp);
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::merge(const hyperloglog& other) {
+  if (precision_ != other.precision_) {
+    throw std::runtime_error("Error: hyperloglog precision mismatch");
+  }
+  if (this == &other) return;
+
+  if (other.is_sparse()) {
+    for (auto it : other.sparse_) {
+      update(it.first, it.second);
+    }
+    return;
+  }
+
+  if (is_sparse()) {
+    densify();
+  }
+  hll::merge_registers(registers_.get(), other.registers_.get(),
+                       register_count());
+}
+
+template <typename K, typename H>
+void hyperloglog<K, H>::swap(hyperloglog& other) noexcept {
+  std::swap(precision_, other.precision_);
+  sparse_.swap(other.sparse_);
+  registers_.swap(other.registers_);
+}
+
+template <typename K, typename H>
+double hyperloglog<K, H>::estimate() const {
+  double m = static_cast<double>(register_count());
+  hll::register_sum total{0.0, 0};
+  if (is_sparse()) {
+    for (auto it : sparse_) {
+      total.sum += std::ldexp(1.0, -it.second);
+    }
+    total.zeros = register_count() - sparse_.size();
+    total.sum += static_cast<double>(total.zeros);
+  } else {
+    total = hll::sum_registers(registers_.get(), register_count());
+  }
+
+  double raw = hll::alpha(register_count()) * m * m / total.sum;
+  if (raw <= 2.5 * m && total.zeros) {
+    return m * std::log(m / static_cast<double>(total.zeros));
+  }
+  return raw;
+}
+
+template <typename K, typename H>
+Vector<uint8_t> hyperloglog<K, H>::serialize() const {
+  size_type payload = is_sparse()
+                          ? 4 + sparse_.size() * hll::sparse_entry_size
+                          : register_count();
+  Vector<uint8_t> out(hll::header_size + payload);
+  uint8_t* it = out.data();
+  *it++ = hll::format_version;
+  *it++ = precision_;
+  *it++ = is_sparse() ? hll::sparse_format : hll::dense_format;
+
+  if (!is_sparse()) {
+    std::copy_n(registers_.get(), register_count(), it);
+    return out;
+  }
+
+  uint32_t entries = static_cast<uint32_t>(sparse_.size());
+  for (int shift = 0; shift < 32; shift += 8) {
+    *it++ = static_cast<uint8_t>(entries >> shift);
+  }
+  for (auto entry : sparse_) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      *it++ = static_cast<uint8_t>(entry.first >> shift);
+    }
+    *it++ = entry.second;
+  }
+  return out;
+}
+
+template <typename K, typename H>
+hyperloglog<K, H> hyperloglog<K, H>::deserialize(const uint8_t* data,
+                                                 size_type size) {
+  auto read32 = [](const uint8_t* p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+      value = (value << 8) | p[i];
+    }
+    return value;
+  };
+
+  if (size < hll::header_size || data[0] != hll::format_version ||
+      data[1] < hll::min_precision || data[1] > hll::max_precision) {
+    throw std::runtime_error("Error: malformed hyperloglog data");
+  }
+
+  hyperloglog result(data[1]);
+  const uint8_t* it = data + hll::header_size;
+  size_type payload = size - hll::header_size;
+
+  if (data[2] == hll::dense_format && payload == result.register_count()) {
+    result.registers_ = std::make_unique<uint8_t[]>(payload);
+    for (size_type i = 0; i < payload; ++i) {
+      if (it[i] > result.max_rank()) {
+        throw std::runtime_error("Error: malformed hyperloglog data");
+      }
+      result.registers_[i] = it[i];
+    }
+    return result;
+  }
+
+  if (data[2] != hll::sparse_format || payload < 4 ||
+      (payload - 4) != read32(it) * hll::sparse_entry_size) {
+    throw std::runtime_error("Error: malformed hyperloglog data");
+  }
+  for (it += 4; it != data + size; it += hll::sparse_entry_size) {
+    uint32_t index = read32(it);
+    uint8_t rank = it[4];
+    if (index >= result.register_count() || !rank ||
+        rank > result.max_rank()) {
+      throw std::runtime_error("Error: malformed hyperloglog data");
+    }
+    result.update(index, rank);
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "vector_allocator.h"
+
+namespace containers {
+
+// Log-linear histogram in the style of HdrHistogram. Values below 2^7 get
+// exact buckets; above that each power of two is split into 64 buckets, so
+// any recorded value is reported within 1/64 of itself. Recording is a
+// relaxed atomic increment and never blocks.
+class hdr_histogram {
+ public:
+  static constexpr unsigned sub_bucket_bits = 7;
+  static constexpr unsigned value_bits = 40;
+  static constexpr uint64_t highest_trackable = (uint64_t{1} << value_bits) - 1;
+
+  hdr_histogram() = default;
+  hdr_histogram(const hdr_histogram& other) = delete;
+  hdr_histogram& operator=(const hdr_histogram& other) = delete;
+
+  void record(uint64_t value) noexcept;
+  void reset() noexcept;
+
+  uint64_t count() const noexcept {
+    return total_.load(std::memory_order_relaxed);
+  }
+  uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+  uint64_t percentile(double percent) const noexcept;
+
+ private:
+  static constexpr size_t sub_count = size_t{1} << sub_bucket_bits;
+  static constexpr size_t half_count = sub_count / 2;
+  static constexpr size_t bucket_count =
+      sub_count + (value_bits - sub_bucket_bits) * half_count;
+
+  static size_t index_of(uint64_t value) noexcept;
+  static uint64_t highest_equivalent(size_t index) noexcept;
+
+  alignas(cache_line_size) std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> max_{0};
+  std::atomic<uint64_t> counts_[bucket_count]{};
+};
+
+inline size_t hdr_histogram::index_of(uint64_t value) noexcept {
+  value = std::min(value, highest_trackable);
+  if (value < sub_count) return static_cast<size_t>(value);
+
+  unsigned shift = 64 - __builtin_clzll(value) - sub_bucket_bits;
+  size_t top = static_cast<size_t>(value >> shift);
+  return sub_count + (shift - 1) * half_count + (top - half_count);
+}
+
+inline uint64_t hdr_histogram::highest_equivalent(size_t index) noexcept {
+  if (index < sub_count) return index;
+
+  size_t offset = index - sub_count;
+  unsigned shift = static_cast<unsigned>(offset / half_count) + 1;
+  uint64_t top = half_count + offset % half_count;
+  return (top << shift) + (uint64_t{1} << shift) - 1;
+}
+
+inline void hdr_histogram::record(uint64_t value) noexcept {
+  counts_[index_of(value)].fetch_add(1, std::memory_order_relaxed);
+  total_.fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t seen = max_.load(std::memory_order_relaxed);
+  while (value > seen && !max_.compare_exchange_weak(
+                             seen, value, std::memory_order_relaxed)) {
+  }
+}
+
+inline void hdr_histogram::reset() noexcept {
+  for (auto& counter : counts_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  total_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+inline uint64_t hdr_histogram::percentile(double percent) const noexcept {
+  uint64_t total = count();
+  if (!total) return 0;
+
+  percent = std::clamp(percent, 0.0, 100.0);
+  uint64_t target = static_cast<uint64_t>(percent / 100.0 * total + 0.5);
+  target = std::max<uint64_t>(target, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < bucket_count; ++i) {
+    seen += counts_[i].load(std::memory_order_relaxed);
+    if (seen >= target) {
+      // The last bucket also holds values clamped to highest_trackable.
+      return i + 1 == bucket_count ? max()
+                                   : std::min(highest_equivalent(i), max());
+    }
+  }
+  return max();
+}
+
+}
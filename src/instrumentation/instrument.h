@@ -0,0 +1,22 @@
+#pragma once
+
+// Building with -DCONTAINERS_INSTRUMENT makes the containers time their
+// operations into instrumentation::stats_for<Container>(); otherwise
+// CONTAINERS_MEASURE expands to nothing.
+#if defined(CONTAINERS_INSTRUMENT)
+
+#include <type_traits>
+
+#include "latency.h"
+
+#define CONTAINERS_MEASURE(op)                                        \
+  ::containers::instrumentation::scoped_timer containers_timer_(      \
+      ::containers::instrumentation::stats_for<std::remove_cv_t<      \
+          std::remove_reference_t<decltype(*this)>>>()                \
+          [::containers::instrumentation::operation::op])
+
+#else
+
+#define CONTAINERS_MEASURE(op)
+
+#endif
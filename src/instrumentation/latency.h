@@ -0,0 +1,193 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+#include "hdr_histogram.h"
+
+namespace containers {
+
+namespace instrumentation {
+
+enum class operation : uint8_t {
+  insert,
+  find,
+  erase,
+  push,
+  pop,
+  growth,
+  rehash,
+};
+
+constexpr size_t operation_count = 7;
+
+inline const char* operation_name(operation op) noexcept {
+  static constexpr const char* names[operation_count] = {
+      "insert", "find", "erase", "push", "pop", "growth", "rehash"};
+  return names[static_cast<size_t>(op)];
+}
+
+struct latency_summary {
+  std::string container;
+  operation op;
+  uint64_t count;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+};
+
+class operation_stats;
+
+class registry {
+ public:
+  static registry& instance() {
+    static registry global;
+    return global;
+  }
+
+  void add(operation_stats* stats) {
+    std::lock_guard<std::mutex> guard(lock_);
+    stats_.push_back(stats);
+  }
+  void remove(operation_stats* stats);
+  std::vector<latency_summary> summaries();
+  void dump(std::ostream& out);
+  void reset();
+
+ private:
+  registry() = default;
+
+  std::mutex lock_;
+  std::vector<operation_stats*> stats_;
+};
+
+// Latency histograms for one container type or instance, one per operation.
+// Every set registers itself so registry::dump() can report all of them.
+class operation_stats {
+ public:
+  explicit operation_stats(std::string name) : name_(std::move(name)) {
+    registry::instance().add(this);
+  }
+  operation_stats(const operation_stats& other) = delete;
+  operation_stats& operator=(const operation_stats& other) = delete;
+  ~operation_stats() { registry::instance().remove(this); }
+
+  const std::string& name() const noexcept { return name_; }
+  hdr_histogram& operator[](operation op) noexcept {
+    return histograms_[static_cast<size_t>(op)];
+  }
+  const hdr_histogram& operator[](operation op) const noexcept {
+    return histograms_[static_cast<size_t>(op)];
+  }
+  void reset() noexcept {
+    for (auto& histogram : histograms_) {
+      histogram.reset();
+    }
+  }
+  latency_summary summary(operation op) const noexcept {
+    const hdr_histogram& h = (*this)[op];
+    return {name_,
+            op,
+            h.count(),
+            h.percentile(50.0),
+            h.percentile(99.0),
+            h.percentile(99.9),
+            h.max()};
+  }
+
+ private:
+  std::string name_;
+  hdr_histogram histograms_[operation_count];
+};
+
+inline void registry::remove(operation_stats* stats) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto& it : stats_) {
+    if (it == stats) {
+      it = stats_.back();
+      stats_.pop_back();
+      return;
+    }
+  }
+}
+
+inline std::vector<latency_summary> registry::summaries() {
+  std::lock_guard<std::mutex> guard(lock_);
+  std::vector<latency_summary> result;
+  for (auto* stats : stats_) {
+    for (size_t op = 0; op < operation_count; ++op) {
+      latency_summary line = stats->summary(static_cast<operation>(op));
+      if (line.count) result.push_back(line);
+    }
+  }
+  return result;
+}
+
+inline void registry::dump(std::ostream& out) {
+  for (auto& line : summaries()) {
+    out << line.container << ' ' << operation_name(line.op)
+        << " count=" << line.count << " p50=" << line.p50
+        << "ns p99=" << line.p99 << "ns p99.9=" << line.p999
+        << "ns max=" << line.max << "ns\n";
+  }
+}
+
+inline void registry::reset() {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto* stats : stats_) {
+    stats->reset();
+  }
+}
+
+inline std::string type_name(const std::type_info& type) {
+#if __has_include(<cxxabi.h>)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+  if (demangled) {
+    std::string name(demangled);
+    std::free(demangled);
+    return name;
+  }
+#endif
+  return type.name();
+}
+
+template <typename Container>
+operation_stats& stats_for() {
+  static operation_stats stats(type_name(typeid(Container)));
+  return stats;
+}
+
+class scoped_timer {
+ public:
+  explicit scoped_timer(hdr_histogram& histogram) noexcept
+      : histogram_(histogram), start_(clock::now()) {}
+  scoped_timer(const scoped_timer& other) = delete;
+  scoped_timer& operator=(const scoped_timer& other) = delete;
+  ~scoped_timer() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - start_);
+    histogram_.record(static_cast<uint64_t>(elapsed.count()));
+  }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  hdr_histogram& histogram_;
+  clock::time_point start_;
+};
+
+}  // namespace instrumentation
+
+}
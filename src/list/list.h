@@ -37,8 +37,8 @@ class List {
   const_iterator cbegin() const;
   const_iterator cend() const;
 
-  const_reference front();
-  const_reference back();
+  reference front();
+  reference back();
 
   bool empty() const noexcept;
   size_type size() const noexcept;
@@ -57,12 +57,14 @@ class List {
 
   void erase(iterator pos);
   void push_back(const_reference value);
+  void push_back(value_type&& value);
   void pop_back();
   void push_front(const_reference value);
   void pop_front();
   void swap(List<T>& other);
   void merge(List<T>& other);
   void splice(const_iterator pos, List<T>& other);
+  void splice(const_iterator pos, List<T>& other, const_iterator it);
   void reverse();
   void unique();
   void sort();
@@ -106,6 +108,11 @@ void List<T>::push_back(const_reference value) {
   insert_many_back(value);
 }
 
+template <typename T>
+void List<T>::push_back(value_type&& value) {
+  insert_many_back(std::move(value));
+}
+
 template <typename T>
 template <typename... Args>
 void List<T>::insert_many_back(Args&&... args) {
@@ -224,12 +231,12 @@ typename List<T>::const_iterator List<T>::cend() const {
 }
 
 template <typename T>
-typename List<T>::const_reference List<T>::front() {
+typename List<T>::reference List<T>::front() {
   return head->get_data();
 }
 
 template <typename T>
-typename List<T>::const_reference List<T>::back() {
+typename List<T>::reference List<T>::back() {
   return tail->get_data();
 }
 
@@ -295,6 +302,10 @@ void List<T>::erase(iterator pos) {
   node_ptr current = pos.get_ptr();
   node_ptr prev = current->prev();
   node_ptr next = current->next();
+  if (!next) {
+    pop_back();
+    return;
+  }
 
   prev->set_next(next);
   next->set_prev(prev);
@@ -372,6 +383,52 @@ void List<T>::splice(const_iterator pos, List<T>& other) {
   }
 }
 
+template <typename T>
+void List<T>::splice(const_iterator pos, List<T>& other, const_iterator it) {
+  if (this == &other && pos == it) {
+    return;
+  }
+  bool at_end = pos == cend();
+
+  node_ptr current = it.get_ptr();
+  node_ptr prev = current->prev();
+  node_ptr next = current->next();
+  if (prev) {
+    prev->set_next(next);
+  } else {
+    other.head = next;
+  }
+  if (next) {
+    next->set_prev(prev);
+  } else {
+    other.tail = prev;
+  }
+  --other.size_;
+
+  if (at_end) {
+    current->set_next(nullptr);
+    current->set_prev(tail);
+    if (tail) {
+      tail->set_next(current);
+    } else {
+      head = current;
+    }
+    tail = current;
+  } else {
+    node_ptr after = pos.get_ptr();
+    node_ptr before = after->prev();
+    current->set_next(after);
+    current->set_prev(before);
+    after->set_prev(current);
+    if (before) {
+      before->set_next(current);
+    } else {
+      head = current;
+    }
+  }
+  ++size_;
+}
+
 template <typename T>
 void List<T>::reverse() {
   if (empty()) {
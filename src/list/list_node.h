@@ -9,7 +9,7 @@ class ListNode {
  public:
   ListNode() = default;
   explicit ListNode(const T& data) noexcept : data_(data) {}
-  explicit ListNode(T&& data) noexcept : data_(data) {}
+  explicit ListNode(T&& data) noexcept : data_(std::move(data)) {}
   template <typename... Args>
   explicit ListNode(Args&&... args) {
     ((data_ = std::forward<Args>(args)), ...);
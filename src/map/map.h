@@ -1,13 +1,14 @@
 #pragma once
 
-#include "hash_table.h"
+#include "small_table.h"
 
 namespace containers {
 
-template <typename K, typename V, typename H = std::hash<K>>
+template <typename K, typename V, typename H = fast_hash<K>,
+          size_t N = default_small_size>
 class Map {
  public:
-  using table = containers::hash_table<K, V, H>;
+  using table = containers::small_table<K, V, H, N>;
   using key_type = K;
   using mapped_type = V;
   using value_type = std::pair<key_type, mapped_type>;
@@ -33,6 +34,13 @@ class Map {
   size_type size() const noexcept { return t.size(); }
   bool empty() const noexcept { return t.empty(); }
   void clear() { return t.clear(); }
+  void shrink_to_fit() { t.shrink_to_fit(); }
+  void set_min_load_factor(double factor) noexcept {
+    t.set_min_load_factor(factor);
+  }
+  void set_incremental_rehash(bool enabled) noexcept {
+    t.set_incremental_rehash(enabled);
+  }
 
   iterator begin() { return t.begin(); }
   iterator end() { return t.end(); }
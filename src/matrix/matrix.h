@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+#include "vector_allocator.h"
+
+namespace containers {
+
+// Layouts map (row, col) to a storage offset. Every block x block tile that
+// starts on a multiple of block keeps its rows contiguous, which the blocked
+// kernels below rely on.
+struct row_major {
+  static constexpr size_t block = 32;
+
+  static size_t storage(size_t rows, size_t cols) noexcept {
+    return rows * cols;
+  }
+  static size_t offset(size_t row, size_t col, size_t cols) noexcept {
+    return row * cols + col;
+  }
+};
+
+template <size_t Tile = 32>
+struct tiled {
+  static_assert(Tile && (Tile & (Tile - 1)) == 0,
+                "tile size must be a power of two");
+  static constexpr size_t block = Tile;
+
+  static size_t padded(size_t n) noexcept {
+    return (n + Tile - 1) & ~(Tile - 1);
+  }
+  static size_t storage(size_t rows, size_t cols) noexcept {
+    return padded(rows) * padded(cols);
+  }
+  static size_t offset(size_t row, size_t col, size_t cols) noexcept {
+    size_t tile = (row / Tile) * (padded(cols) / Tile) + col / Tile;
+    return tile * Tile * Tile + (row % Tile) * Tile + col % Tile;
+  }
+};
+
+template <typename Matrix>
+class matrix_line {
+ public:
+  using size_type = size_t;
+
+  matrix_line(Matrix& owner, size_type index, bool row) noexcept
+      : owner_(owner), index_(index), row_(row) {}
+
+  size_type size() const noexcept {
+    return row_ ? owner_.cols() : owner_.rows();
+  }
+  decltype(auto) operator[](size_type pos) const noexcept {
+    return row_ ? owner_(index_, pos) : owner_(pos, index_);
+  }
+  decltype(auto) at(size_type pos) const {
+    return row_ ? owner_.at(index_, pos) : owner_.at(pos, index_);
+  }
+
+ private:
+  Matrix& owner_;
+  size_type index_;
+  bool row_;
+};
+
+template <typename T, typename Layout = row_major>
+class matrix {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using size_type = size_t;
+  using layout_type = Layout;
+
+  matrix() = default;
+  matrix(size_type rows, size_type cols, const_reference value = {});
+  template <typename OtherLayout>
+  explicit matrix(const matrix<T, OtherLayout>& other);
+  matrix(const matrix& other) = default;
+  matrix(matrix&& other) noexcept = default;
+  ~matrix() = default;
+
+  matrix& operator=(const matrix& other);
+  matrix& operator=(matrix&& other) noexcept = default;
+
+  size_type rows() const noexcept { return rows_; }
+  size_type cols() const noexcept { return cols_; }
+  size_type size() const noexcept { return rows_ * cols_; }
+  bool empty() const noexcept { return !size(); }
+
+  pointer data() noexcept { return data_.data(); }
+  const_pointer data() const noexcept { return data_.data(); }
+
+  reference operator()(size_type row, size_type col) noexcept {
+    return data()[Layout::offset(row, col, cols_)];
+  }
+  const_reference operator()(size_type row, size_type col) const noexcept {
+    return data()[Layout::offset(row, col, cols_)];
+  }
+  reference at(size_type row, size_type col);
+  const_reference at(size_type row, size_type col) const;
+
+  matrix_line<matrix> row(size_type index) noexcept {
+    return {*this, index, true};
+  }
+  matrix_line<const matrix> row(size_type index) const noexcept {
+    return {*this, index, true};
+  }
+  matrix_line<matrix> col(size_type index) noexcept {
+    return {*this, index, false};
+  }
+  matrix_line<const matrix> col(size_type index) const noexcept {
+    return {*this, index, false};
+  }
+
+  void fill(const_reference value) { data_.fill(value); }
+  void swap(matrix& other) noexcept;
+  matrix transpose() const;
+
+  friend bool operator==(const matrix& a, const matrix& b) noexcept {
+    if (a.rows_ != b.rows_ || a.cols_ != b.cols_) return false;
+    for (size_type i = 0; i < a.rows_; ++i) {
+      for (size_type j = 0; j < a.cols_; ++j) {
+        if (!(a(i, j) == b(i, j))) return false;
+      }
+    }
+    return true;
+  }
+  friend bool operator!=(const matrix& a, const matrix& b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  size_type rows_{0};
+  size_type cols_{0};
+  Vector<value_type, aligned_allocator<value_type>> data_;
+};
+
+template <typename T, typename L>
+matrix<T, L>::matrix(size_type rows, size_type cols, const_reference value)
+    : rows_(rows), cols_(cols), data_(L::storage(rows, cols), value) {}
+
+template <typename T, typename L>
+template <typename OtherLayout>
+matrix<T, L>::matrix(const matrix<T, OtherLayout>& other)
+    : matrix(other.rows(), other.cols()) {
+  for (size_type i = 0; i < rows_; ++i) {
+    for (size_type j = 0; j < cols_; ++j) {
+      (*this)(i, j) = other(i, j);
+    }
+  }
+}
+
+template <typename T, typename L>
+matrix<T, L>& matrix<T, L>::operator=(const matrix& other) {
+  if (this != &other) {
+    matrix tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename L>
+void matrix<T, L>::swap(matrix& other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  data_.swap(other.data_);
+}
+
+template <typename T, typename L>
+typename matrix<T, L>::reference matrix<T, L>::at(size_type row,
+                                                  size_type col) {
+  if (row >= rows_ || col >= cols_) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  return (*this)(row, col);
+}
+
+template <typename T, typename L>
+typename matrix<T, L>::const_reference matrix<T, L>::at(size_type row,
+                                                        size_type col) const {
+  if (row >= rows_ || col >= cols_) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  return (*this)(row, col);
+}
+
+template <typename T, typename L>
+matrix<T, L> matrix<T, L>::transpose() const {
+  constexpr size_type block = L::block;
+  matrix result(cols_, rows_);
+  for (size_type ib = 0; ib < rows_; ib += block) {
+    size_type i_end = std::min(ib + block, rows_);
+    for (size_type jb = 0; jb < cols_; jb += block) {
+      size_type j_end = std::min(jb + block, cols_);
+      for (size_type i = ib; i < i_end; ++i) {
+        for (size_type j = jb; j < j_end; ++j) {
+          result(j, i) = (*this)(i, j);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T, typename L>
+matrix<T, L> multiply(const matrix<T, L>& a, const matrix<T, L>& b) {
+  if (a.cols() != b.rows()) {
+    throw std::runtime_error("Error: matrix dimensions do not match");
+  }
+
+  constexpr size_t block = L::block;
+  size_t n = a.rows(), m = a.cols(), p = b.cols();
+  matrix<T, L> c(n, p);
+  for (size_t ib = 0; ib < n; ib += block) {
+    size_t i_end = std::min(ib + block, n);
+    for (size_t kb = 0; kb < m; kb += block) {
+      size_t k_end = std::min(kb + block, m);
+      for (size_t jb = 0; jb < p; jb += block) {
+        size_t width = std::min(jb + block, p) - jb;
+        for (size_t i = ib; i < i_end; ++i) {
+          T* out = &c(i, jb);
+          for (size_t k = kb; k < k_end; ++k) {
+            const T scale = a(i, k);
+            const T* in = &b(k, jb);
+            for (size_t j = 0; j < width; ++j) {
+              out[j] += scale * in[j];
+            }
+          }
+        }
+      }
+    }
+  }
+  return c;
+}
+
+template <typename T, typename L>
+matrix<T, L> operator*(const matrix<T, L>& a, const matrix<T, L>& b) {
+  return multiply(a, b);
+}
+
+}
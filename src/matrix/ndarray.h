@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+#include "vector_allocator.h"
+
+namespace containers {
+
+template <typename T, size_t Rank>
+class ndarray {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using size_type = size_t;
+  using extents_type = std::array<size_type, Rank>;
+
+  static_assert(Rank > 0, "ndarray rank must be positive");
+
+  ndarray() = default;
+  explicit ndarray(const extents_type& extents, const_reference value = {});
+  ndarray(const ndarray& other) = default;
+  ndarray(ndarray&& other) noexcept = default;
+  ~ndarray() = default;
+
+  ndarray& operator=(const ndarray& other);
+  ndarray& operator=(ndarray&& other) noexcept = default;
+
+  static constexpr size_type rank() noexcept { return Rank; }
+  size_type size() const noexcept { return data_.size(); }
+  bool empty() const noexcept { return !size(); }
+  size_type extent(size_type dim) const noexcept { return extents_[dim]; }
+  size_type stride(size_type dim) const noexcept { return strides_[dim]; }
+  const extents_type& extents() const noexcept { return extents_; }
+  const extents_type& strides() const noexcept { return strides_; }
+
+  pointer data() noexcept { return data_.data(); }
+  const_pointer data() const noexcept { return data_.data(); }
+  pointer begin() noexcept { return data(); }
+  pointer end() noexcept { return data() + size(); }
+  const_pointer begin() const noexcept { return data(); }
+  const_pointer end() const noexcept { return data() + size(); }
+
+  template <typename... Index>
+  reference operator()(Index... index) noexcept {
+    return data()[offset(index...)];
+  }
+  template <typename... Index>
+  const_reference operator()(Index... index) const noexcept {
+    return data()[offset(index...)];
+  }
+  template <typename... Index>
+  reference at(Index... index) {
+    check(index...);
+    return data()[offset(index...)];
+  }
+  template <typename... Index>
+  const_reference at(Index... index) const {
+    check(index...);
+    return data()[offset(index...)];
+  }
+
+  void fill(const_reference value) { data_.fill(value); }
+  void swap(ndarray& other) noexcept;
+
+ private:
+  template <typename... Index>
+  size_type offset(Index... index) const noexcept {
+    static_assert(sizeof...(Index) == Rank,
+                  "ndarray needs one index per dimension");
+    size_type position[] = {static_cast<size_type>(index)...};
+    size_type result = 0;
+    for (size_type dim = 0; dim < Rank; ++dim) {
+      result += position[dim] * strides_[dim];
+    }
+    return result;
+  }
+  template <typename... Index>
+  void check(Index... index) const {
+    size_type position[] = {static_cast<size_type>(index)...};
+    for (size_type dim = 0; dim < Rank; ++dim) {
+      if (position[dim] >= extents_[dim]) {
+        throw std::out_of_range("Error: index is out of range");
+      }
+    }
+  }
+  static size_type element_count(const extents_type& extents) noexcept {
+    size_type count = 1;
+    for (size_type extent : extents) count *= extent;
+    return count;
+  }
+
+  extents_type extents_{};
+  extents_type strides_{};
+  Vector<value_type, aligned_allocator<value_type>> data_;
+};
+
+template <typename T, size_t R>
+ndarray<T, R>::ndarray(const extents_type& extents, const_reference value)
+    : extents_(extents), data_(element_count(extents), value) {
+  size_type stride = 1;
+  for (size_type dim = R; dim-- > 0;) {
+    strides_[dim] = stride;
+    stride *= extents_[dim];
+  }
+}
+
+template <typename T, size_t R>
+ndarray<T, R>& ndarray<T, R>::operator=(const ndarray& other) {
+  if (this != &other) {
+    ndarray tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, size_t R>
+void ndarray<T, R>::swap(ndarray& other) noexcept {
+  std::swap(extents_, other.extents_);
+  std::swap(strides_, other.strides_);
+  data_.swap(other.data_);
+}
+
+}
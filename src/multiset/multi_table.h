@@ -0,0 +1,177 @@
+#pragma once
+
+#include "hash_table.h"
+#include "list.h"
+
+namespace containers {
+
+template <typename K, typename V, typename H = fast_hash<K>>
+class multi_table {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using storage = List<value_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename storage::iterator;
+  using size_type = size_t;
+
+  multi_table() = default;
+  multi_table(const multi_table& other);
+  multi_table(multi_table&& other) = default;
+  ~multi_table() = default;
+
+  multi_table& operator=(const multi_table& other);
+  multi_table& operator=(multi_table&& other) = default;
+
+  size_type size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+  void clear();
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+
+  iterator insert(const value_type& value);
+  template <typename... Args>
+  Vector<iterator> insert_many(Args&&... args);
+
+  void erase(iterator pos);
+  size_type erase(const key_type& key);
+  void swap(multi_table& other);
+
+  iterator find(const key_type& key);
+  bool contains(const key_type& key) const noexcept;
+  size_type count(const key_type& key);
+  std::pair<iterator, iterator> equal_range(const key_type& key);
+
+ private:
+  struct group {
+    iterator first;
+    size_type count{0};
+  };
+
+  storage entries_;
+  hash_table<K, group, H> index_;
+};
+
+template <typename K, typename V, typename H>
+multi_table<K, V, H>::multi_table(const multi_table& other) {
+  for (auto& it : other.entries_) {
+    insert(it);
+  }
+}
+
+template <typename K, typename V, typename H>
+multi_table<K, V, H>& multi_table<K, V, H>::operator=(
+    const multi_table& other) {
+  if (this != &other) {
+    multi_table tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename H>
+void multi_table<K, V, H>::clear() {
+  entries_.clear();
+  index_.clear();
+}
+
+template <typename K, typename V, typename H>
+typename multi_table<K, V, H>::iterator multi_table<K, V, H>::insert(
+    const value_type& value) {
+  group& g = index_[value.first];
+  if (!g.count) {
+    entries_.push_back(value);
+    g.first = --entries_.end();
+  } else {
+    g.first = entries_.insert(g.first, value);
+  }
+  ++g.count;
+
+  return g.first;
+}
+
+template <typename K, typename V, typename H>
+template <typename... Args>
+Vector<typename multi_table<K, V, H>::iterator>
+multi_table<K, V, H>::insert_many(Args&&... args) {
+  return {insert(std::forward<Args>(args))...};
+}
+
+template <typename K, typename V, typename H>
+void multi_table<K, V, H>::erase(iterator pos) {
+  auto index = index_.find(pos->first);
+  group& g = index->second;
+  if (g.first == pos) {
+    ++g.first;
+  }
+  if (!--g.count) {
+    index_.erase(index);
+  }
+  entries_.erase(pos);
+}
+
+template <typename K, typename V, typename H>
+typename multi_table<K, V, H>::size_type multi_table<K, V, H>::erase(
+    const key_type& key) {
+  auto index = index_.find(key);
+  if (index == index_.end()) {
+    return 0;
+  }
+
+  size_type removed = index->second.count;
+  iterator it = index->second.first;
+  index_.erase(index);
+  for (size_type i = 0; i < removed; ++i) {
+    entries_.erase(it++);
+  }
+
+  return removed;
+}
+
+template <typename K, typename V, typename H>
+void multi_table<K, V, H>::swap(multi_table& other) {
+  entries_.swap(other.entries_);
+  index_.swap(other.index_);
+}
+
+template <typename K, typename V, typename H>
+typename multi_table<K, V, H>::iterator multi_table<K, V, H>::find(
+    const key_type& key) {
+  auto index = index_.find(key);
+  return index == index_.end() ? end() : index->second.first;
+}
+
+template <typename K, typename V, typename H>
+bool multi_table<K, V, H>::contains(const key_type& key) const noexcept {
+  return index_.contains(key);
+}
+
+template <typename K, typename V, typename H>
+typename multi_table<K, V, H>::size_type multi_table<K, V, H>::count(
+    const key_type& key) {
+  auto index = index_.find(key);
+  return index == index_.end() ? 0 : index->second.count;
+}
+
+template <typename K, typename V, typename H>
+std::pair<typename multi_table<K, V, H>::iterator,
+          typename multi_table<K, V, H>::iterator>
+multi_table<K, V, H>::equal_range(const key_type& key) {
+  auto index = index_.find(key);
+  if (index == index_.end()) {
+    return {end(), end()};
+  }
+
+  iterator first = index->second.first;
+  iterator last = first;
+  for (size_type i = 0; i < index->second.count; ++i) {
+    ++last;
+  }
+
+  return {first, last};
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "multi_table.h"
+
+namespace containers {
+
+template <typename K, typename V, typename H = fast_hash<K>>
+class Multimap {
+ public:
+  using table = multi_table<K, V, H>;
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type&;
+  using iterator = typename table::iterator;
+  using size_type = size_t;
+
+  Multimap() = default;
+
+  Multimap(std::initializer_list<value_type> const& items) {
+    for (auto& it : items) {
+      insert(it);
+    }
+  }
+
+  Multimap(const Multimap& other) = default;
+  Multimap(Multimap&& other) = default;
+  ~Multimap() noexcept = default;
+
+  Multimap& operator=(const Multimap& other) = default;
+  Multimap& operator=(Multimap&& other) noexcept = default;
+
+  size_type size() const noexcept { return t.size(); }
+  bool empty() const noexcept { return t.empty(); }
+  void clear() { t.clear(); }
+
+  iterator begin() { return t.begin(); }
+  iterator end() { return t.end(); }
+
+  void erase(iterator pos) { t.erase(pos); }
+  size_type erase(const key_type& key) { return t.erase(key); }
+  void swap(Multimap& other) { t.swap(other.t); }
+
+  iterator insert(const value_type& value) { return t.insert(value); }
+  iterator insert(const key_type& key, const mapped_type& value) {
+    return t.insert(std::make_pair(key, value));
+  }
+  template <typename... Args>
+  containers::Vector<iterator> insert_many(Args&&... args) {
+    return t.insert_many(std::forward<Args>(args)...);
+  }
+
+  size_type count(const key_type& key) { return t.count(key); }
+  iterator find(const key_type& key) { return t.find(key); }
+  bool contains(const key_type& key) const noexcept { return t.contains(key); }
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    return t.equal_range(key);
+  }
+
+ private:
+  table t;
+};
+
+}
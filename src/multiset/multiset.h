@@ -0,0 +1,66 @@
+#pragma once
+
+#include "multi_table.h"
+
+namespace containers {
+
+template <typename K, typename H = fast_hash<K>>
+class Multiset {
+ public:
+  using table = multi_table<K, K, H>;
+  using key_type = K;
+  using mapped_type = K;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type&;
+  using iterator = typename table::iterator;
+  using size_type = size_t;
+
+  Multiset() = default;
+
+  Multiset(std::initializer_list<mapped_type> const& items) {
+    for (auto& it : items) {
+      insert(it);
+    }
+  }
+
+  Multiset(const Multiset& other) = default;
+  Multiset(Multiset&& other) = default;
+  ~Multiset() noexcept = default;
+
+  Multiset& operator=(const Multiset& other) = default;
+  Multiset& operator=(Multiset&& other) noexcept = default;
+
+  iterator begin() { return t.begin(); }
+  iterator end() { return t.end(); }
+
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+
+  void clear() { t.clear(); }
+  iterator insert(const mapped_type& value) { return t.insert({value, value}); }
+  void erase(iterator pos) { t.erase(pos); }
+  size_type erase(const key_type& key) { return t.erase(key); }
+  void swap(Multiset& other) { t.swap(other.t); }
+  void merge(Multiset& other) {
+    for (auto& it : other) {
+      insert(it.second);
+    }
+    other.clear();
+  }
+
+  size_type count(const key_type& key) { return t.count(key); }
+  iterator find(const key_type& key) { return t.find(key); }
+  bool contains(const key_type& key) const noexcept { return t.contains(key); }
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    return t.equal_range(key);
+  }
+  template <typename... Args>
+  containers::Vector<iterator> insert_many(Args&&... args) {
+    return {insert(std::forward<Args>(args))...};
+  }
+
+ private:
+  table t;
+};
+
+}
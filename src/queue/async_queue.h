@@ -0,0 +1,151 @@
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "executor.h"
+#include "queue.h"
+
+namespace containers {
+
+template <typename T>
+class async_queue {
+ public:
+  using value_type = T;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+  class pop_awaiter {
+   public:
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+      handle_ = handle;
+      return owner_->suspend(this);
+    }
+    std::optional<value_type> await_resume() { return std::move(value_); }
+
+   private:
+    friend class async_queue;
+
+    explicit pop_awaiter(async_queue* owner) noexcept : owner_(owner) {}
+
+    async_queue* owner_;
+    pop_awaiter* next_{nullptr};
+    std::coroutine_handle<> handle_;
+    std::optional<value_type> value_;
+  };
+
+  explicit async_queue(executor& ex) : executor_(&ex) {}
+  async_queue(const async_queue& other) = delete;
+  async_queue& operator=(const async_queue& other) = delete;
+  ~async_queue() = default;
+
+  size_type size() const;
+  bool empty() const { return !size(); }
+  bool closed() const;
+  void close();
+
+  bool push(const_reference value) { return emplace(value); }
+  bool push(value_type&& value) { return emplace(std::move(value)); }
+  bool try_pop(value_type& value);
+  pop_awaiter pop() noexcept { return pop_awaiter(this); }
+
+ private:
+  template <typename U>
+  bool emplace(U&& value);
+  bool suspend(pop_awaiter* waiter);
+
+  executor* executor_;
+  mutable std::mutex lock_;
+  queue<value_type> items_;
+  pop_awaiter* head_{nullptr};
+  pop_awaiter* tail_{nullptr};
+  bool closed_{false};
+};
+
+template <typename T>
+typename async_queue<T>::size_type async_queue<T>::size() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return items_.size();
+}
+
+template <typename T>
+bool async_queue<T>::closed() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return closed_;
+}
+
+template <typename T>
+void async_queue<T>::close() {
+  pop_awaiter* waiters = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    closed_ = true;
+    waiters = head_;
+    head_ = tail_ = nullptr;
+  }
+  while (waiters) {
+    pop_awaiter* next = waiters->next_;
+    executor_->post(waiters->handle_);
+    waiters = next;
+  }
+}
+
+template <typename T>
+template <typename U>
+bool async_queue<T>::emplace(U&& value) {
+  pop_awaiter* waiter = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (closed_) return false;
+    if (!head_) {
+      items_.push(std::forward<U>(value));
+      return true;
+    }
+
+    // Hand the value straight to the oldest waiter; it never touches the
+    // buffer and cannot be stolen by a try_pop() before it resumes.
+    waiter = head_;
+    head_ = waiter->next_;
+    if (!head_) tail_ = nullptr;
+    waiter->value_.emplace(std::forward<U>(value));
+  }
+  executor_->post(waiter->handle_);
+  return true;
+}
+
+template <typename T>
+bool async_queue<T>::try_pop(value_type& value) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (items_.empty()) return false;
+  value = std::move(items_.front());
+  items_.pop();
+  return true;
+}
+
+template <typename T>
+bool async_queue<T>::suspend(pop_awaiter* waiter) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!items_.empty()) {
+    waiter->value_.emplace(std::move(items_.front()));
+    items_.pop();
+    return false;
+  }
+  if (closed_) return false;
+
+  if (tail_) {
+    tail_->next_ = waiter;
+  } else {
+    head_ = waiter;
+  }
+  tail_ = waiter;
+  return true;
+}
+
+}
+
+#endif
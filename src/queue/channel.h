@@ -0,0 +1,244 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "circular_buffer.h"
+
+namespace containers {
+
+template <typename T>
+class channel {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+  explicit channel(size_type capacity);
+  channel(const channel& other) = delete;
+  channel(channel&& other) = delete;
+  ~channel() = default;
+
+  channel& operator=(const channel& other) = delete;
+  channel& operator=(channel&& other) = delete;
+
+  size_type capacity() const noexcept { return capacity_; }
+  size_type size() const;
+  bool empty() const { return !size(); }
+  bool closed() const;
+  void close();
+
+  bool push(const_reference value) { return emplace_until(value, nullptr); }
+  bool push(value_type&& value) {
+    return emplace_until(std::move(value), nullptr);
+  }
+  bool try_push(const_reference value);
+  bool try_push(value_type&& value);
+  template <typename Rep, typename Period>
+  bool push_for(value_type value,
+                const std::chrono::duration<Rep, Period>& timeout);
+  template <typename InputIt>
+  InputIt push_batch(InputIt first, InputIt last);
+
+  bool pop(reference value) { return pop_until(value, nullptr); }
+  bool try_pop(reference value);
+  template <typename Rep, typename Period>
+  bool pop_for(reference value,
+               const std::chrono::duration<Rep, Period>& timeout);
+  template <typename OutputIt>
+  size_type pop_batch(OutputIt out, size_type max);
+
+ private:
+  using clock = std::chrono::steady_clock;
+  using lock_type = std::unique_lock<std::mutex>;
+
+  template <typename U>
+  bool emplace_until(U&& value, const clock::time_point* deadline);
+  bool pop_until(reference value, const clock::time_point* deadline);
+  bool wait(std::condition_variable& cv, size_type& waiters, lock_type& lock,
+            const clock::time_point* deadline);
+  void wake(std::condition_variable& cv, size_type waiters, size_type count);
+
+  size_type capacity_;
+  mutable std::mutex lock_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  size_type pop_waiters_{0};
+  size_type push_waiters_{0};
+  bool closed_{false};
+  circular_buffer<T> buffer_;
+};
+
+template <typename T>
+channel<T>::channel(size_type capacity) : capacity_(capacity) {
+  if (!capacity) {
+    throw std::out_of_range("Error: channel capacity must be positive");
+  }
+  buffer_ = circular_buffer<T>(capacity);
+}
+
+template <typename T>
+typename channel<T>::size_type channel<T>::size() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return buffer_.size();
+}
+
+template <typename T>
+bool channel<T>::closed() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return closed_;
+}
+
+template <typename T>
+void channel<T>::close() {
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    closed_ = true;
+  }
+  not_empty_.notify_all();
+  not_full_.notify_all();
+}
+
+template <typename T>
+bool channel<T>::wait(std::condition_variable& cv, size_type& waiters,
+                      lock_type& lock, const clock::time_point* deadline) {
+  ++waiters;
+  bool woken = true;
+  if (deadline) {
+    woken = cv.wait_until(lock, *deadline) == std::cv_status::no_timeout;
+  } else {
+    cv.wait(lock);
+  }
+  --waiters;
+  return woken;
+}
+
+template <typename T>
+void channel<T>::wake(std::condition_variable& cv, size_type waiters,
+                      size_type count) {
+  if (!waiters || !count) return;
+  if (count == 1) {
+    cv.notify_one();
+  } else {
+    cv.notify_all();
+  }
+}
+
+template <typename T>
+template <typename U>
+bool channel<T>::emplace_until(U&& value, const clock::time_point* deadline) {
+  lock_type lock(lock_);
+  while (!closed_ && buffer_.full()) {
+    if (!wait(not_full_, push_waiters_, lock, deadline) && buffer_.full()) {
+      return false;
+    }
+  }
+  if (closed_) return false;
+
+  buffer_.push_back(std::forward<U>(value));
+  size_type waiters = pop_waiters_;
+  lock.unlock();
+  wake(not_empty_, waiters, 1);
+  return true;
+}
+
+template <typename T>
+bool channel<T>::try_push(const_reference value) {
+  return push_for(value, clock::duration::zero());
+}
+
+template <typename T>
+bool channel<T>::try_push(value_type&& value) {
+  return push_for(std::move(value), clock::duration::zero());
+}
+
+template <typename T>
+template <typename Rep, typename Period>
+bool channel<T>::push_for(value_type value,
+                          const std::chrono::duration<Rep, Period>& timeout) {
+  clock::time_point deadline =
+      clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+  return emplace_until(std::move(value), &deadline);
+}
+
+template <typename T>
+template <typename InputIt>
+InputIt channel<T>::push_batch(InputIt first, InputIt last) {
+  while (first != last) {
+    lock_type lock(lock_);
+    while (!closed_ && buffer_.full()) {
+      wait(not_full_, push_waiters_, lock, nullptr);
+    }
+    if (closed_) break;
+
+    size_type pushed = 0;
+    for (; first != last && !buffer_.full(); ++first, ++pushed) {
+      buffer_.push_back(*first);
+    }
+    size_type waiters = pop_waiters_;
+    lock.unlock();
+    wake(not_empty_, waiters, pushed);
+  }
+  return first;
+}
+
+template <typename T>
+bool channel<T>::pop_until(reference value,
+                           const clock::time_point* deadline) {
+  lock_type lock(lock_);
+  while (!closed_ && buffer_.empty()) {
+    if (!wait(not_empty_, pop_waiters_, lock, deadline) && buffer_.empty()) {
+      return false;
+    }
+  }
+  if (buffer_.empty()) return false;
+
+  value = std::move(buffer_.front());
+  buffer_.pop_front();
+  size_type waiters = push_waiters_;
+  lock.unlock();
+  wake(not_full_, waiters, 1);
+  return true;
+}
+
+template <typename T>
+bool channel<T>::try_pop(reference value) {
+  return pop_for(value, clock::duration::zero());
+}
+
+template <typename T>
+template <typename Rep, typename Period>
+bool channel<T>::pop_for(reference value,
+                         const std::chrono::duration<Rep, Period>& timeout) {
+  clock::time_point deadline =
+      clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+  return pop_until(value, &deadline);
+}
+
+template <typename T>
+template <typename OutputIt>
+typename channel<T>::size_type channel<T>::pop_batch(OutputIt out,
+                                                     size_type max) {
+  if (!max) return 0;
+
+  lock_type lock(lock_);
+  while (!closed_ && buffer_.empty()) {
+    wait(not_empty_, pop_waiters_, lock, nullptr);
+  }
+
+  size_type popped = 0;
+  for (; popped < max && !buffer_.empty(); ++popped) {
+    *out++ = std::move(buffer_.front());
+    buffer_.pop_front();
+  }
+  size_type waiters = push_waiters_;
+  lock.unlock();
+  wake(not_full_, waiters, popped);
+  return popped;
+}
+
+}
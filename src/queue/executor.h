@@ -0,0 +1,135 @@
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "queue.h"
+
+namespace containers {
+
+class executor {
+ public:
+  virtual ~executor() = default;
+  virtual void post(std::coroutine_handle<> handle) = 0;
+
+  auto schedule() noexcept {
+    struct awaiter {
+      executor* target;
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) {
+        target->post(handle);
+      }
+      void await_resume() const noexcept {}
+    };
+    return awaiter{this};
+  }
+};
+
+class manual_executor : public executor {
+ public:
+  void post(std::coroutine_handle<> handle) override {
+    std::lock_guard<std::mutex> guard(lock_);
+    ready_.push(handle);
+  }
+
+  bool run_one() {
+    std::coroutine_handle<> handle;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (ready_.empty()) return false;
+      handle = ready_.front();
+      ready_.pop();
+    }
+    handle.resume();
+    return true;
+  }
+
+  size_t run() {
+    size_t resumed = 0;
+    while (run_one()) {
+      ++resumed;
+    }
+    return resumed;
+  }
+
+ private:
+  std::mutex lock_;
+  queue<std::coroutine_handle<>> ready_;
+};
+
+class thread_pool_executor : public executor {
+ public:
+  explicit thread_pool_executor(
+      size_t threads = std::thread::hardware_concurrency()) {
+    if (!threads) threads = 1;
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+  thread_pool_executor(const thread_pool_executor& other) = delete;
+  thread_pool_executor& operator=(const thread_pool_executor& other) = delete;
+
+  ~thread_pool_executor() override {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_t size() const noexcept { return workers_.size(); }
+
+  void post(std::coroutine_handle<> handle) override {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      ready_.push(handle);
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  void work() {
+    std::unique_lock<std::mutex> lock(lock_);
+    for (;;) {
+      wake_.wait(lock, [this] { return stopping_ || !ready_.empty(); });
+      if (ready_.empty()) return;
+
+      std::coroutine_handle<> handle = ready_.front();
+      ready_.pop();
+      lock.unlock();
+      handle.resume();
+      lock.lock();
+    }
+  }
+
+  std::mutex lock_;
+  std::condition_variable wake_;
+  queue<std::coroutine_handle<>> ready_;
+  bool stopping_{false};
+  std::vector<std::thread> workers_;
+};
+
+struct detached_task {
+  struct promise_type {
+    detached_task get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}
+
+#endif
@@ -31,13 +31,14 @@ class queue {
     return *this;
   }
 
-  const_reference front() { return c.front(); }
-  const_reference back() { return c.back(); }
+  reference front() { return c.front(); }
+  reference back() { return c.back(); }
 
   bool empty() const noexcept { return c.empty(); }
   size_type size() const noexcept { return c.size(); }
 
   void push(const_reference value) { c.push_back(value); }
+  void push(value_type&& value) { c.push_back(std::move(value)); }
 
   template <typename... Args>
   void insert_many(Args... args) {
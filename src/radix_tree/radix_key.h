@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace containers {
+
+// Byte view of a key whose lexicographic order matches the key order.
+// Integers are stored inline as big-endian bytes, so the view stays valid
+// when the object is copied.
+class radix_bytes {
+ public:
+  radix_bytes(const char* data, size_t size) noexcept
+      : external_(data), size_(size) {}
+  template <typename U>
+  explicit radix_bytes(U value) noexcept : size_(sizeof(U)) {
+    for (size_t i = sizeof(U); i-- > 0;) {
+      storage_[i] = static_cast<char>(value & 0xFF);
+      value >>= 8;
+    }
+  }
+
+  std::string_view view() const noexcept {
+    return {external_ ? external_ : storage_, size_};
+  }
+
+ private:
+  const char* external_{nullptr};
+  size_t size_;
+  char storage_[sizeof(unsigned long long)]{};
+};
+
+template <typename K, typename = void>
+struct radix_key;
+
+template <typename CharT, typename Traits, typename Alloc>
+struct radix_key<std::basic_string<CharT, Traits, Alloc>> {
+  static_assert(sizeof(CharT) == 1, "radix_tree needs byte-sized characters");
+
+  static radix_bytes bytes(
+      const std::basic_string<CharT, Traits, Alloc>& key) noexcept {
+    return radix_bytes(reinterpret_cast<const char*>(key.data()), key.size());
+  }
+};
+
+template <typename K>
+struct radix_key<
+    K, std::enable_if_t<std::is_integral_v<K> && !std::is_same_v<K, bool>>> {
+  static radix_bytes bytes(K key) noexcept {
+    using unsigned_type = std::make_unsigned_t<K>;
+    unsigned_type value = static_cast<unsigned_type>(key);
+    if constexpr (std::is_signed_v<K>) {
+      value ^= unsigned_type{1} << (sizeof(K) * 8 - 1);
+    }
+    return radix_bytes(value);
+  }
+};
+
+}
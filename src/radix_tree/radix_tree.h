@@ -0,0 +1,928 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "radix_key.h"
+#include "vector.h"
+
+namespace containers {
+
+template <typename K, typename V, typename KeyTraits = radix_key<K>>
+class radix_tree {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type&;
+  using size_type = size_t;
+
+  class iterator;
+
+  radix_tree() = default;
+  radix_tree(std::initializer_list<value_type> const& items);
+  radix_tree(const radix_tree& other);
+  radix_tree(radix_tree&& other) noexcept;
+  ~radix_tree() { destroy(root_); }
+
+  radix_tree& operator=(const radix_tree& other);
+  radix_tree& operator=(radix_tree&& other) noexcept;
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return !size_; }
+  void clear();
+
+  iterator begin() { return iterator(root_); }
+  iterator end() { return iterator(); }
+
+  mapped_type& at(const key_type& key);
+  mapped_type& operator[](const key_type& key);
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const key_type& key,
+                                   const mapped_type& value);
+  std::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                             const mapped_type& value);
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  void erase(iterator pos) { erase(pos->first); }
+  size_type erase(const key_type& key);
+  void swap(radix_tree& other) noexcept;
+
+  iterator find(const key_type& key);
+  bool contains(const key_type& key) const noexcept;
+  std::pair<iterator, iterator> prefix_scan(const key_type& prefix);
+
+ private:
+  enum class node_type : uint8_t { leaf, node4, node16, node48, node256 };
+
+  struct node {
+    explicit node(node_type t) noexcept : type(t) {}
+    node_type type;
+  };
+
+  struct leaf : node {
+    explicit leaf(const value_type& v) : node(node_type::leaf), value(v) {}
+    value_type value;
+  };
+
+  struct inner : node {
+    using node::node;
+    uint16_t count{0};
+    std::string prefix;
+    leaf* terminal{nullptr};
+  };
+
+  struct node4 : inner {
+    node4() : inner(node_type::node4) {}
+    uint8_t keys[4]{};
+    node* children[4]{};
+  };
+
+  struct node16 : inner {
+    node16() : inner(node_type::node16) {}
+    alignas(16) uint8_t keys[16]{};
+    node* children[16]{};
+  };
+
+  struct node48 : inner {
+    node48() : inner(node_type::node48) {}
+    uint8_t index[256]{};
+    node* children[48]{};
+  };
+
+  struct node256 : inner {
+    node256() : inner(node_type::node256) {}
+    node* children[256]{};
+  };
+
+  static std::string_view bytes_of(const radix_bytes& bytes) noexcept {
+    return bytes.view();
+  }
+  static radix_bytes key_bytes(const key_type& key) noexcept {
+    return KeyTraits::bytes(key);
+  }
+  static bool is_leaf(const node* n) noexcept {
+    return n->type == node_type::leaf;
+  }
+  static leaf* as_leaf(node* n) noexcept { return static_cast<leaf*>(n); }
+  static inner* as_inner(node* n) noexcept { return static_cast<inner*>(n); }
+
+  static int search16(const node16* n, uint8_t byte) noexcept;
+  static int lower16(const node16* n, uint8_t byte) noexcept;
+  static node** find_child(inner* n, uint8_t byte, int* position = nullptr);
+  static std::pair<int, node*> next_child(inner* n, int from) noexcept;
+  static uint8_t child_byte(const inner* n, int position) noexcept;
+  static void add_child(node*& slot, uint8_t byte, node* child);
+  static void remove_child(inner* n, uint8_t byte);
+  static void normalize(node*& slot);
+  template <typename Target, typename Source>
+  static Target* convert(Source* from);
+
+  static void destroy(node* n) noexcept;
+  static void free_inner(inner* n) noexcept;
+  static node* clone(const node* n);
+
+  leaf* lookup(std::string_view key) const noexcept;
+  std::pair<leaf*, bool> insert_bytes(node*& slot, std::string_view key,
+                                      size_type depth,
+                                      const value_type& value);
+  bool erase_bytes(node*& slot, std::string_view key, size_type depth);
+
+  node* root_{nullptr};
+  size_type size_{0};
+};
+
+template <typename K, typename V, typename T>
+class radix_tree<K, V, T>::iterator {
+ public:
+  using value_type = typename radix_tree::value_type;
+  using reference = value_type&;
+  using pointer = value_type*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  iterator() = default;
+  iterator(const iterator& other) = default;
+  iterator(iterator&& other) noexcept = default;
+
+  iterator& operator=(const iterator& other) {
+    if (this != &other) {
+      current_ = other.current_;
+      stack_ = Vector<frame>(other.stack_);
+    }
+    return *this;
+  }
+  iterator& operator=(iterator&& other) noexcept = default;
+
+  reference operator*() const noexcept { return current_->value; }
+  pointer operator->() const noexcept { return &current_->value; }
+
+  iterator& operator++() {
+    advance();
+    return *this;
+  }
+  iterator operator++(int) {
+    auto tmp{*this};
+    ++(*this);
+    return tmp;
+  }
+
+  friend bool operator==(const iterator& a, const iterator& b) noexcept {
+    return a.current_ == b.current_;
+  }
+  friend bool operator!=(const iterator& a, const iterator& b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  friend class radix_tree;
+
+  // Each frame remembers which child of an inner node comes next; -1 means
+  // the node's terminal leaf has not been visited yet.
+  struct frame {
+    inner* n;
+    int next;
+  };
+
+  explicit iterator(node* subtree) {
+    if (!subtree) return;
+    if (is_leaf(subtree)) {
+      current_ = as_leaf(subtree);
+      return;
+    }
+    stack_.push_back(frame{as_inner(subtree), -1});
+    advance();
+  }
+
+  void advance() {
+    current_ = nullptr;
+    while (!stack_.empty()) {
+      frame& top = stack_.data()[stack_.size() - 1];
+      if (top.next < 0) {
+        top.next = 0;
+        if (top.n->terminal) {
+          current_ = top.n->terminal;
+          return;
+        }
+      }
+
+      auto child = next_child(top.n, top.next);
+      if (!child.second) {
+        stack_.pop_back();
+        continue;
+      }
+      top.next = child.first + 1;
+      if (is_leaf(child.second)) {
+        current_ = as_leaf(child.second);
+        return;
+      }
+      stack_.push_back(frame{as_inner(child.second), -1});
+    }
+  }
+
+  leaf* current_{nullptr};
+  Vector<frame> stack_;
+};
+
+template <typename K, typename V, typename T>
+radix_tree<K, V, T>::radix_tree(
+    std::initializer_list<value_type> const& items) {
+  for (auto& it : items) {
+    insert(it);
+  }
+}
+
+template <typename K, typename V, typename T>
+radix_tree<K, V, T>::radix_tree(const radix_tree& other)
+    : root_(clone(other.root_)), size_(other.size_) {}
+
+template <typename K, typename V, typename T>
+radix_tree<K, V, T>::radix_tree(radix_tree&& other) noexcept
+    : root_(other.root_), size_(other.size_) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename K, typename V, typename T>
+radix_tree<K, V, T>& radix_tree<K, V, T>::operator=(const radix_tree& other) {
+  if (this != &other) {
+    radix_tree tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename T>
+radix_tree<K, V, T>& radix_tree<K, V, T>::operator=(
+    radix_tree&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::clear() {
+  destroy(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::swap(radix_tree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+}
+
+template <typename K, typename V, typename T>
+int radix_tree<K, V, T>::search16(const node16* n, uint8_t byte) noexcept {
+#if defined(__SSE2__)
+  __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i*>(n->keys));
+  __m128i match = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), keys);
+  int mask = _mm_movemask_epi8(match) & ((1 << n->count) - 1);
+  return mask ? __builtin_ctz(mask) : -1;
+#else
+  for (int i = 0; i < n->count; ++i) {
+    if (n->keys[i] == byte) return i;
+  }
+  return -1;
+#endif
+}
+
+template <typename K, typename V, typename T>
+int radix_tree<K, V, T>::lower16(const node16* n, uint8_t byte) noexcept {
+#if defined(__SSE2__)
+  // SSE2 only compares signed bytes, so both sides are biased by 0x80.
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+  __m128i keys = _mm_xor_si128(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(n->keys)), bias);
+  __m128i probe =
+      _mm_xor_si128(_mm_set1_epi8(static_cast<char>(byte)), bias);
+  int mask =
+      _mm_movemask_epi8(_mm_cmplt_epi8(probe, keys)) & ((1 << n->count) - 1);
+  return mask ? __builtin_ctz(mask) : n->count;
+#else
+  int i = 0;
+  while (i < n->count && n->keys[i] < byte) ++i;
+  return i;
+#endif
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::node** radix_tree<K, V, T>::find_child(
+    inner* n, uint8_t byte, int* position) {
+  int pos = -1;
+  node** slot = nullptr;
+  switch (n->type) {
+    case node_type::node4: {
+      auto* n4 = static_cast<node4*>(n);
+      for (int i = 0; i < n4->count; ++i) {
+        if (n4->keys[i] == byte) {
+          pos = i;
+          slot = &n4->children[i];
+          break;
+        }
+      }
+      break;
+    }
+    case node_type::node16: {
+      auto* n16 = static_cast<node16*>(n);
+      pos = search16(n16, byte);
+      if (pos >= 0) slot = &n16->children[pos];
+      break;
+    }
+    case node_type::node48: {
+      auto* n48 = static_cast<node48*>(n);
+      if (n48->index[byte]) {
+        pos = byte;
+        slot = &n48->children[n48->index[byte] - 1];
+      }
+      break;
+    }
+    default: {
+      auto* n256 = static_cast<node256*>(n);
+      if (n256->children[byte]) {
+        pos = byte;
+        slot = &n256->children[byte];
+      }
+      break;
+    }
+  }
+  if (position) *position = pos;
+  return slot;
+}
+
+template <typename K, typename V, typename T>
+std::pair<int, typename radix_tree<K, V, T>::node*>
+radix_tree<K, V, T>::next_child(inner* n, int from) noexcept {
+  switch (n->type) {
+    case node_type::node4: {
+      auto* n4 = static_cast<node4*>(n);
+      if (from < n4->count) return {from, n4->children[from]};
+      break;
+    }
+    case node_type::node16: {
+      auto* n16 = static_cast<node16*>(n);
+      if (from < n16->count) return {from, n16->children[from]};
+      break;
+    }
+    case node_type::node48: {
+      auto* n48 = static_cast<node48*>(n);
+      for (int i = from; i < 256; ++i) {
+        if (n48->index[i]) return {i, n48->children[n48->index[i] - 1]};
+      }
+      break;
+    }
+    default: {
+      auto* n256 = static_cast<node256*>(n);
+      for (int i = from; i < 256; ++i) {
+        if (n256->children[i]) return {i, n256->children[i]};
+      }
+      break;
+    }
+  }
+  return {-1, nullptr};
+}
+
+template <typename K, typename V, typename T>
+uint8_t radix_tree<K, V, T>::child_byte(const inner* n, int position) noexcept {
+  switch (n->type) {
+    case node_type::node4:
+      return static_cast<const node4*>(n)->keys[position];
+    case node_type::node16:
+      return static_cast<const node16*>(n)->keys[position];
+    default:
+      return static_cast<uint8_t>(position);
+  }
+}
+
+template <typename K, typename V, typename T>
+template <typename Target, typename Source>
+Target* radix_tree<K, V, T>::convert(Source* from) {
+  auto* to = new Target();
+  to->prefix = std::move(from->prefix);
+  to->terminal = from->terminal;
+  node* target = to;
+  for (int pos = 0;;) {
+    auto child = next_child(from, pos);
+    if (!child.second) break;
+    add_child(target, child_byte(from, child.first), child.second);
+    pos = child.first + 1;
+  }
+  delete from;
+  return to;
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::add_child(node*& slot, uint8_t byte, node* child) {
+  inner* n = as_inner(slot);
+  switch (n->type) {
+    case node_type::node4: {
+      auto* n4 = static_cast<node4*>(n);
+      if (n4->count == 4) {
+        slot = convert<node16>(n4);
+        add_child(slot, byte, child);
+        return;
+      }
+      int pos = 0;
+      while (pos < n4->count && n4->keys[pos] < byte) ++pos;
+      std::move_backward(n4->keys + pos, n4->keys + n4->count,
+                         n4->keys + n4->count + 1);
+      std::move_backward(n4->children + pos, n4->children + n4->count,
+                         n4->children + n4->count + 1);
+      n4->keys[pos] = byte;
+      n4->children[pos] = child;
+      break;
+    }
+    case node_type::node16: {
+      auto* n16 = static_cast<node16*>(n);
+      if (n16->count == 16) {
+        slot = convert<node48>(n16);
+        add_child(slot, byte, child);
+        return;
+      }
+      int pos = lower16(n16, byte);
+      std::move_backward(n16->keys + pos, n16->keys + n16->count,
+                         n16->keys + n16->count + 1);
+      std::move_backward(n16->children + pos, n16->children + n16->count,
+                         n16->children + n16->count + 1);
+      n16->keys[pos] = byte;
+      n16->children[pos] = child;
+      break;
+    }
+    case node_type::node48: {
+      auto* n48 = static_cast<node48*>(n);
+      if (n48->count == 48) {
+        slot = convert<node256>(n48);
+        add_child(slot, byte, child);
+        return;
+      }
+      int free_slot = 0;
+      while (n48->children[free_slot]) ++free_slot;
+      n48->children[free_slot] = child;
+      n48->index[byte] = static_cast<uint8_t>(free_slot + 1);
+      break;
+    }
+    default:
+      static_cast<node256*>(n)->children[byte] = child;
+      break;
+  }
+  ++n->count;
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::remove_child(inner* n, uint8_t byte) {
+  switch (n->type) {
+    case node_type::node4: {
+      auto* n4 = static_cast<node4*>(n);
+      int pos = 0;
+      while (n4->keys[pos] != byte) ++pos;
+      std::move(n4->keys + pos + 1, n4->keys + n4->count, n4->keys + pos);
+      std::move(n4->children + pos + 1, n4->children + n4->count,
+                n4->children + pos);
+      n4->children[n4->count - 1] = nullptr;
+      break;
+    }
+    case node_type::node16: {
+      auto* n16 = static_cast<node16*>(n);
+      int pos = search16(n16, byte);
+      std::move(n16->keys + pos + 1, n16->keys + n16->count, n16->keys + pos);
+      std::move(n16->children + pos + 1, n16->children + n16->count,
+                n16->children + pos);
+      n16->children[n16->count - 1] = nullptr;
+      break;
+    }
+    case node_type::node48: {
+      auto* n48 = static_cast<node48*>(n);
+      n48->children[n48->index[byte] - 1] = nullptr;
+      n48->index[byte] = 0;
+      break;
+    }
+    default:
+      static_cast<node256*>(n)->children[byte] = nullptr;
+      break;
+  }
+  --n->count;
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::normalize(node*& slot) {
+  inner* n = as_inner(slot);
+  if (!n->count) {
+    slot = n->terminal;
+    free_inner(n);
+    return;
+  }
+
+  if (n->count == 1 && !n->terminal) {
+    auto only = next_child(n, 0);
+    if (!is_leaf(only.second)) {
+      inner* child = as_inner(only.second);
+      child->prefix = n->prefix +
+                      static_cast<char>(child_byte(n, only.first)) +
+                      child->prefix;
+    }
+    slot = only.second;
+    free_inner(n);
+    return;
+  }
+
+  switch (n->type) {
+    case node_type::node16:
+      if (n->count <= 3) slot = convert<node4>(static_cast<node16*>(n));
+      break;
+    case node_type::node48:
+      if (n->count <= 12) slot = convert<node16>(static_cast<node48*>(n));
+      break;
+    case node_type::node256:
+      if (n->count <= 37) slot = convert<node48>(static_cast<node256*>(n));
+      break;
+    default:
+      break;
+  }
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::destroy(node* n) noexcept {
+  if (!n) return;
+  if (is_leaf(n)) {
+    delete as_leaf(n);
+    return;
+  }
+
+  inner* i = as_inner(n);
+  for (int pos = 0;;) {
+    auto child = next_child(i, pos);
+    if (!child.second) break;
+    destroy(child.second);
+    pos = child.first + 1;
+  }
+  delete i->terminal;
+  free_inner(i);
+}
+
+template <typename K, typename V, typename T>
+void radix_tree<K, V, T>::free_inner(inner* n) noexcept {
+  switch (n->type) {
+    case node_type::node4:
+      delete static_cast<node4*>(n);
+      break;
+    case node_type::node16:
+      delete static_cast<node16*>(n);
+      break;
+    case node_type::node48:
+      delete static_cast<node48*>(n);
+      break;
+    default:
+      delete static_cast<node256*>(n);
+      break;
+  }
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::node* radix_tree<K, V, T>::clone(
+    const node* n) {
+  if (!n) return nullptr;
+  if (is_leaf(n)) return new leaf(static_cast<const leaf*>(n)->value);
+
+  inner* copy = nullptr;
+  switch (n->type) {
+    case node_type::node4:
+      copy = new node4(*static_cast<const node4*>(n));
+      break;
+    case node_type::node16:
+      copy = new node16(*static_cast<const node16*>(n));
+      break;
+    case node_type::node48:
+      copy = new node48(*static_cast<const node48*>(n));
+      break;
+    default:
+      copy = new node256(*static_cast<const node256*>(n));
+      break;
+  }
+  if (copy->terminal) {
+    copy->terminal = new leaf(copy->terminal->value);
+  }
+
+  node** children = nullptr;
+  int capacity = 0;
+  switch (n->type) {
+    case node_type::node4:
+      children = static_cast<node4*>(copy)->children;
+      capacity = 4;
+      break;
+    case node_type::node16:
+      children = static_cast<node16*>(copy)->children;
+      capacity = 16;
+      break;
+    case node_type::node48:
+      children = static_cast<node48*>(copy)->children;
+      capacity = 48;
+      break;
+    default:
+      children = static_cast<node256*>(copy)->children;
+      capacity = 256;
+      break;
+  }
+  for (int i = 0; i < capacity; ++i) {
+    children[i] = clone(children[i]);
+  }
+  return copy;
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::leaf* radix_tree<K, V, T>::lookup(
+    std::string_view key) const noexcept {
+  node* n = root_;
+  size_type depth = 0;
+  while (n) {
+    if (is_leaf(n)) {
+      leaf* l = as_leaf(n);
+      return bytes_of(key_bytes(l->value.first)) == key ? l : nullptr;
+    }
+
+    inner* i = as_inner(n);
+    if (key.compare(depth, i->prefix.size(), i->prefix) != 0) return nullptr;
+    depth += i->prefix.size();
+    if (depth == key.size()) return i->terminal;
+
+    node** child = find_child(i, static_cast<uint8_t>(key[depth]));
+    n = child ? *child : nullptr;
+    ++depth;
+  }
+  return nullptr;
+}
+
+template <typename K, typename V, typename T>
+std::pair<typename radix_tree<K, V, T>::leaf*, bool>
+radix_tree<K, V, T>::insert_bytes(node*& slot, std::string_view key,
+                                  size_type depth, const value_type& value) {
+  if (!slot) {
+    leaf* created = new leaf(value);
+    slot = created;
+    ++size_;
+    return {created, true};
+  }
+
+  if (is_leaf(slot)) {
+    leaf* existing = as_leaf(slot);
+    radix_bytes held = key_bytes(existing->value.first);
+    std::string_view other = bytes_of(held);
+    if (other == key) return {existing, false};
+
+    size_type end = depth;
+    while (end < key.size() && end < other.size() && key[end] == other[end]) {
+      ++end;
+    }
+
+    auto* split = new node4();
+    split->prefix.assign(key.data() + depth, end - depth);
+    node* replacement = split;
+    if (other.size() == end) {
+      split->terminal = existing;
+    } else {
+      add_child(replacement, static_cast<uint8_t>(other[end]), existing);
+    }
+
+    leaf* created = new leaf(value);
+    if (key.size() == end) {
+      split->terminal = created;
+    } else {
+      add_child(replacement, static_cast<uint8_t>(key[end]), created);
+    }
+    slot = replacement;
+    ++size_;
+    return {created, true};
+  }
+
+  inner* n = as_inner(slot);
+  size_type matched = 0;
+  while (matched < n->prefix.size() && depth + matched < key.size() &&
+         n->prefix[matched] == key[depth + matched]) {
+    ++matched;
+  }
+
+  if (matched < n->prefix.size()) {
+    auto* split = new node4();
+    split->prefix = n->prefix.substr(0, matched);
+    uint8_t byte = static_cast<uint8_t>(n->prefix[matched]);
+    n->prefix.erase(0, matched + 1);
+    node* replacement = split;
+    add_child(replacement, byte, n);
+
+    leaf* created = new leaf(value);
+    if (depth + matched == key.size()) {
+      split->terminal = created;
+    } else {
+      add_child(replacement, static_cast<uint8_t>(key[depth + matched]),
+                created);
+    }
+    slot = replacement;
+    ++size_;
+    return {created, true};
+  }
+
+  depth += matched;
+  if (depth == key.size()) {
+    if (n->terminal) return {n->terminal, false};
+    n->terminal = new leaf(value);
+    ++size_;
+    return {n->terminal, true};
+  }
+
+  uint8_t byte = static_cast<uint8_t>(key[depth]);
+  node** child = find_child(n, byte);
+  if (child) return insert_bytes(*child, key, depth + 1, value);
+
+  leaf* created = new leaf(value);
+  add_child(slot, byte, created);
+  ++size_;
+  return {created, true};
+}
+
+template <typename K, typename V, typename T>
+bool radix_tree<K, V, T>::erase_bytes(node*& slot, std::string_view key,
+                                      size_type depth) {
+  if (!slot) return false;
+  if (is_leaf(slot)) {
+    if (bytes_of(key_bytes(as_leaf(slot)->value.first)) != key) return false;
+    delete as_leaf(slot);
+    slot = nullptr;
+    return true;
+  }
+
+  inner* n = as_inner(slot);
+  if (key.compare(depth, n->prefix.size(), n->prefix) != 0) return false;
+  depth += n->prefix.size();
+
+  if (depth == key.size()) {
+    if (!n->terminal) return false;
+    delete n->terminal;
+    n->terminal = nullptr;
+    normalize(slot);
+    return true;
+  }
+
+  uint8_t byte = static_cast<uint8_t>(key[depth]);
+  node** child = find_child(n, byte);
+  if (!child || !erase_bytes(*child, key, depth + 1)) return false;
+  if (!*child) {
+    remove_child(n, byte);
+  }
+  normalize(slot);
+  return true;
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::mapped_type& radix_tree<K, V, T>::at(
+    const key_type& key) {
+  radix_bytes bytes = key_bytes(key);
+  leaf* l = lookup(bytes_of(bytes));
+  if (!l) {
+    throw std::out_of_range("Error: key doesn't exist");
+  }
+  return l->value.second;
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::mapped_type& radix_tree<K, V, T>::operator[](
+    const key_type& key) {
+  radix_bytes bytes = key_bytes(key);
+  leaf* l = lookup(bytes_of(bytes));
+  if (!l) {
+    l = insert_bytes(root_, bytes_of(bytes), 0, value_type{key, mapped_type{}})
+            .first;
+  }
+  return l->value.second;
+}
+
+template <typename K, typename V, typename T>
+std::pair<typename radix_tree<K, V, T>::iterator, bool>
+radix_tree<K, V, T>::insert(const value_type& value) {
+  radix_bytes bytes = key_bytes(value.first);
+  bool inserted = insert_bytes(root_, bytes_of(bytes), 0, value).second;
+  return {find(value.first), inserted};
+}
+
+template <typename K, typename V, typename T>
+std::pair<typename radix_tree<K, V, T>::iterator, bool>
+radix_tree<K, V, T>::insert(const key_type& key, const mapped_type& value) {
+  return insert(std::make_pair(key, value));
+}
+
+template <typename K, typename V, typename T>
+std::pair<typename radix_tree<K, V, T>::iterator, bool>
+radix_tree<K, V, T>::insert_or_assign(const key_type& key,
+                                      const mapped_type& value) {
+  std::pair<iterator, bool> it = insert(key, value);
+  if (!it.second) {
+    it.first->second = value;
+  }
+  return it;
+}
+
+template <typename K, typename V, typename T>
+template <typename... Args>
+Vector<std::pair<typename radix_tree<K, V, T>::iterator, bool>>
+radix_tree<K, V, T>::insert_many(Args&&... args) {
+  return {insert(std::forward<Args>(args))...};
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::size_type radix_tree<K, V, T>::erase(
+    const key_type& key) {
+  radix_bytes bytes = key_bytes(key);
+  if (!erase_bytes(root_, bytes_of(bytes), 0)) return 0;
+  --size_;
+  return 1;
+}
+
+template <typename K, typename V, typename T>
+bool radix_tree<K, V, T>::contains(const key_type& key) const noexcept {
+  radix_bytes bytes = key_bytes(key);
+  return lookup(bytes_of(bytes));
+}
+
+template <typename K, typename V, typename T>
+typename radix_tree<K, V, T>::iterator radix_tree<K, V, T>::find(
+    const key_type& key) {
+  radix_bytes bytes = key_bytes(key);
+  std::string_view view = bytes_of(bytes);
+
+  iterator it;
+  node* n = root_;
+  size_type depth = 0;
+  while (n) {
+    if (is_leaf(n)) {
+      leaf* l = as_leaf(n);
+      if (bytes_of(key_bytes(l->value.first)) != view) break;
+      it.current_ = l;
+      return it;
+    }
+
+    inner* i = as_inner(n);
+    if (view.compare(depth, i->prefix.size(), i->prefix) != 0) break;
+    depth += i->prefix.size();
+    if (depth == view.size()) {
+      if (!i->terminal) break;
+      it.stack_.push_back({i, 0});
+      it.current_ = i->terminal;
+      return it;
+    }
+
+    int position = -1;
+    node** child = find_child(i, static_cast<uint8_t>(view[depth]), &position);
+    if (!child) break;
+    it.stack_.push_back({i, position + 1});
+    n = *child;
+    ++depth;
+  }
+  return end();
+}
+
+template <typename K, typename V, typename T>
+std::pair<typename radix_tree<K, V, T>::iterator,
+          typename radix_tree<K, V, T>::iterator>
+radix_tree<K, V, T>::prefix_scan(const key_type& prefix) {
+  radix_bytes bytes = key_bytes(prefix);
+  std::string_view view = bytes_of(bytes);
+
+  node* n = root_;
+  size_type depth = 0;
+  while (n) {
+    if (is_leaf(n)) {
+      radix_bytes held = key_bytes(as_leaf(n)->value.first);
+      if (bytes_of(held).substr(0, view.size()) == view) {
+        return {iterator(n), end()};
+      }
+      break;
+    }
+
+    inner* i = as_inner(n);
+    size_type common = std::min(i->prefix.size(), view.size() - depth);
+    if (view.compare(depth, common, i->prefix, 0, common) != 0) break;
+    if (depth + i->prefix.size() >= view.size()) {
+      return {iterator(n), end()};
+    }
+
+    depth += i->prefix.size();
+    node** child = find_child(i, static_cast<uint8_t>(view[depth]));
+    if (!child) break;
+    n = *child;
+    ++depth;
+  }
+  return {end(), end()};
+}
+
+}
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "vector.h"
+
+namespace containers {
+
+constexpr size_t rope_chunk_size = 4096;
+
+// Text stored as an AVL tree of immutable chunks. Nodes and chunks are shared
+// between ropes and only the path to an edit is copied, so copies are O(1)
+// and edits, splits and concatenation are O(log n).
+class rope {
+ public:
+  using value_type = char;
+  using size_type = size_t;
+
+  rope() = default;
+  explicit rope(std::string_view text) : root_(build(text)) {}
+  rope(const rope& other) = default;
+  rope(rope&& other) noexcept = default;
+  ~rope() = default;
+
+  rope& operator=(const rope& other) = default;
+  rope& operator=(rope&& other) noexcept = default;
+
+  size_type size() const noexcept { return length_of(root_); }
+  size_type length() const noexcept { return size(); }
+  bool empty() const noexcept { return !root_; }
+  int height() const noexcept { return height_of(root_); }
+  size_type chunk_count() const noexcept;
+  void clear() noexcept { root_.reset(); }
+  void swap(rope& other) noexcept { root_.swap(other.root_); }
+
+  char at(size_type pos) const;
+  char operator[](size_type pos) const { return at(pos); }
+
+  void insert(size_type pos, std::string_view text);
+  void insert(size_type pos, const rope& other);
+  void erase(size_type pos, size_type count = std::string_view::npos);
+  rope substr(size_type pos, size_type count = std::string_view::npos) const;
+
+  rope& append(std::string_view text) {
+    insert(size(), text);
+    return *this;
+  }
+  rope& append(const rope& other) {
+    root_ = concat(root_, other.root_);
+    return *this;
+  }
+  rope& operator+=(std::string_view text) { return append(text); }
+  rope& operator+=(const rope& other) { return append(other); }
+  friend rope operator+(const rope& a, const rope& b) {
+    rope result(a);
+    result.append(b);
+    return result;
+  }
+
+  template <typename F>
+  void for_each_chunk(F&& visit) const {
+    visit_chunks(root_.get(), visit);
+  }
+  Vector<std::string_view> chunks() const;
+  std::string str() const;
+
+ private:
+  struct node;
+  using node_ptr = std::shared_ptr<const node>;
+  using chunk_ptr = std::shared_ptr<const std::string>;
+
+  struct node {
+    node(node_ptr l, chunk_ptr c, node_ptr r)
+        : left(std::move(l)),
+          right(std::move(r)),
+          chunk(std::move(c)),
+          length(length_of(left) + chunk->size() + length_of(right)),
+          height(1 + std::max(height_of(left), height_of(right))) {}
+
+    node_ptr left;
+    node_ptr right;
+    chunk_ptr chunk;
+    size_type length;
+    int height;
+  };
+
+  explicit rope(node_ptr root) : root_(std::move(root)) {}
+
+  static size_type length_of(const node_ptr& n) noexcept {
+    return n ? n->length : 0;
+  }
+  static int height_of(const node_ptr& n) noexcept {
+    return n ? n->height : 0;
+  }
+  static node_ptr make(node_ptr left, chunk_ptr chunk, node_ptr right) {
+    return std::make_shared<const node>(std::move(left), std::move(chunk),
+                                        std::move(right));
+  }
+  static chunk_ptr make_chunk(std::string_view text) {
+    return std::make_shared<const std::string>(text);
+  }
+
+  static node_ptr rotate_left(const node_ptr& n);
+  static node_ptr rotate_right(const node_ptr& n);
+  static node_ptr join_right(const node_ptr& left, chunk_ptr chunk,
+                             const node_ptr& right);
+  static node_ptr join_left(const node_ptr& left, chunk_ptr chunk,
+                            const node_ptr& right);
+  static node_ptr join(const node_ptr& left, chunk_ptr chunk,
+                       const node_ptr& right);
+  static node_ptr concat(const node_ptr& left, const node_ptr& right);
+  static std::pair<node_ptr, node_ptr> split(const node_ptr& n,
+                                             size_type pos);
+  static std::pair<chunk_ptr, node_ptr> pop_front(const node_ptr& n);
+  static std::pair<node_ptr, chunk_ptr> pop_back(const node_ptr& n);
+  static node_ptr build(std::string_view text);
+  static node_ptr splice(node_ptr left, std::string_view text,
+                         node_ptr right);
+
+  template <typename F>
+  static void visit_chunks(const node* n, F& visit) {
+    while (n) {
+      visit_chunks(n->left.get(), visit);
+      visit(std::string_view(*n->chunk));
+      n = n->right.get();
+    }
+  }
+
+  node_ptr root_;
+};
+
+inline rope::node_ptr rope::rotate_left(const node_ptr& n) {
+  const node_ptr& r = n->right;
+  return make(make(n->left, n->chunk, r->left), r->chunk, r->right);
+}
+
+inline rope::node_ptr rope::rotate_right(const node_ptr& n) {
+  const node_ptr& l = n->left;
+  return make(l->left, l->chunk, make(l->right, n->chunk, n->right));
+}
+
+inline rope::node_ptr rope::join_right(const node_ptr& left, chunk_ptr chunk,
+                                       const node_ptr& right) {
+  if (height_of(left->right) <= height_of(right) + 1) {
+    node_ptr middle = make(left->right, std::move(chunk), right);
+    if (height_of(middle) <= height_of(left->left) + 1) {
+      return make(left->left, left->chunk, middle);
+    }
+    return rotate_left(make(left->left, left->chunk, rotate_right(middle)));
+  }
+
+  node_ptr middle = join_right(left->right, std::move(chunk), right);
+  node_ptr joined = make(left->left, left->chunk, middle);
+  if (height_of(middle) <= height_of(left->left) + 1) return joined;
+  return rotate_left(joined);
+}
+
+inline rope::node_ptr rope::join_left(const node_ptr& left, chunk_ptr chunk,
+                                      const node_ptr& right) {
+  if (height_of(right->left) <= height_of(left) + 1) {
+    node_ptr middle = make(left, std::move(chunk), right->left);
+    if (height_of(middle) <= height_of(right->right) + 1) {
+      return make(middle, right->chunk, right->right);
+    }
+    return rotate_right(make(rotate_left(middle), right->chunk, right->right));
+  }
+
+  node_ptr middle = join_left(left, std::move(chunk), right->left);
+  node_ptr joined = make(middle, right->chunk, right->right);
+  if (height_of(middle) <= height_of(right->right) + 1) return joined;
+  return rotate_right(joined);
+}
+
+inline rope::node_ptr rope::join(const node_ptr& left, chunk_ptr chunk,
+                                 const node_ptr& right) {
+  if (height_of(left) > height_of(right) + 1) {
+    return join_right(left, std::move(chunk), right);
+  }
+  if (height_of(right) > height_of(left) + 1) {
+    return join_left(left, std::move(chunk), right);
+  }
+  return make(left, std::move(chunk), right);
+}
+
+inline rope::node_ptr rope::concat(const node_ptr& left,
+                                   const node_ptr& right) {
+  if (!left) return right;
+  if (!right) return left;
+  auto first = pop_front(right);
+  return join(left, std::move(first.first), first.second);
+}
+
+inline std::pair<rope::chunk_ptr, rope::node_ptr> rope::pop_front(
+    const node_ptr& n) {
+  if (!n->left) return {n->chunk, n->right};
+  auto first = pop_front(n->left);
+  return {std::move(first.first), join(first.second, n->chunk, n->right)};
+}
+
+inline std::pair<rope::node_ptr, rope::chunk_ptr> rope::pop_back(
+    const node_ptr& n) {
+  if (!n->right) return {n->left, n->chunk};
+  auto last = pop_back(n->right);
+  return {join(n->left, n->chunk, last.first), std::move(last.second)};
+}
+
+inline std::pair<rope::node_ptr, rope::node_ptr> rope::split(
+    const node_ptr& n, size_type pos) {
+  if (!n) return {nullptr, nullptr};
+
+  size_type left_length = length_of(n->left);
+  size_type chunk_length = n->chunk->size();
+  if (pos < left_length) {
+    auto parts = split(n->left, pos);
+    return {std::move(parts.first), join(parts.second, n->chunk, n->right)};
+  }
+  if (pos > left_length + chunk_length) {
+    auto parts = split(n->right, pos - left_length - chunk_length);
+    return {join(n->left, n->chunk, parts.first), std::move(parts.second)};
+  }
+
+  size_type offset = pos - left_length;
+  if (offset == 0) return {n->left, join(nullptr, n->chunk, n->right)};
+  if (offset == chunk_length) {
+    return {join(n->left, n->chunk, nullptr), n->right};
+  }
+  std::string_view text(*n->chunk);
+  return {join(n->left, make_chunk(text.substr(0, offset)), nullptr),
+          join(nullptr, make_chunk(text.substr(offset)), n->right)};
+}
+
+inline rope::node_ptr rope::build(std::string_view text) {
+  if (text.empty()) return nullptr;
+
+  size_type pieces = (text.size() + rope_chunk_size - 1) / rope_chunk_size;
+  if (pieces == 1) return make(nullptr, make_chunk(text), nullptr);
+
+  size_type middle = pieces / 2;
+  size_type first = text.size() * middle / pieces;
+  size_type last = text.size() * (middle + 1) / pieces;
+  return make(build(text.substr(0, first)),
+              make_chunk(text.substr(first, last - first)),
+              build(text.substr(last)));
+}
+
+inline rope::node_ptr rope::splice(node_ptr left, std::string_view text,
+                                   node_ptr right) {
+  // Fold the chunks on either side of the edit into the new text while they
+  // fit, so repeated small edits do not fragment the rope.
+  std::string joined(text);
+  if (left) {
+    auto last = pop_back(left);
+    if (last.second->size() + joined.size() <= rope_chunk_size) {
+      joined.insert(0, *last.second);
+      left = std::move(last.first);
+    }
+  }
+  if (right) {
+    auto first = pop_front(right);
+    if (first.first->size() + joined.size() <= rope_chunk_size) {
+      joined.append(*first.first);
+      right = std::move(first.second);
+    }
+  }
+  return concat(concat(left, build(joined)), right);
+}
+
+inline rope::size_type rope::chunk_count() const noexcept {
+  size_type count = 0;
+  for_each_chunk([&count](std::string_view) { ++count; });
+  return count;
+}
+
+inline char rope::at(size_type pos) const {
+  if (pos >= size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  const node* n = root_.get();
+  for (;;) {
+    size_type left_length = length_of(n->left);
+    if (pos < left_length) {
+      n = n->left.get();
+    } else if (pos - left_length < n->chunk->size()) {
+      return (*n->chunk)[pos - left_length];
+    } else {
+      pos -= left_length + n->chunk->size();
+      n = n->right.get();
+    }
+  }
+}
+
+inline void rope::insert(size_type pos, std::string_view text) {
+  if (pos > size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  if (text.empty()) return;
+  auto parts = split(root_, pos);
+  root_ = splice(std::move(parts.first), text, std::move(parts.second));
+}
+
+inline void rope::insert(size_type pos, const rope& other) {
+  if (pos > size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  auto parts = split(root_, pos);
+  root_ = concat(concat(parts.first, other.root_), parts.second);
+}
+
+inline void rope::erase(size_type pos, size_type count) {
+  if (pos > size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  count = std::min(count, size() - pos);
+  if (!count) return;
+
+  auto head = split(root_, pos);
+  auto tail = split(head.second, count);
+  root_ = splice(std::move(head.first), {}, std::move(tail.second));
+}
+
+inline rope rope::substr(size_type pos, size_type count) const {
+  if (pos > size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  count = std::min(count, size() - pos);
+  auto head = split(root_, pos);
+  return rope(split(head.second, count).first);
+}
+
+inline Vector<std::string_view> rope::chunks() const {
+  Vector<std::string_view> result;
+  for_each_chunk([&result](std::string_view chunk) {
+    result.push_back(chunk);
+  });
+  return result;
+}
+
+inline std::string rope::str() const {
+  std::string result;
+  result.reserve(size());
+  for_each_chunk([&result](std::string_view chunk) { result.append(chunk); });
+  return result;
+}
+
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "vector.h"
+
+namespace containers {
+
+template <typename T>
+struct sum_op {
+  T operator()(const T& a, const T& b) const { return a + b; }
+  static T identity() { return T{}; }
+  static T apply(const T& value, const T& delta, size_t length) {
+    return value + delta * static_cast<T>(length);
+  }
+};
+
+template <typename T>
+struct min_op {
+  T operator()(const T& a, const T& b) const { return std::min(a, b); }
+  static T identity() { return std::numeric_limits<T>::max(); }
+  static T apply(const T& value, const T& delta, size_t) {
+    return value + delta;
+  }
+};
+
+template <typename T>
+struct max_op {
+  T operator()(const T& a, const T& b) const { return std::max(a, b); }
+  static T identity() { return std::numeric_limits<T>::lowest(); }
+  static T apply(const T& value, const T& delta, size_t) {
+    return value + delta;
+  }
+};
+
+template <typename T, typename Op = sum_op<T>>
+class segment_tree {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  segment_tree() : segment_tree(0) {}
+  explicit segment_tree(size_type count);
+  explicit segment_tree(const Vector<value_type>& values);
+  segment_tree(const segment_tree& other);
+  segment_tree(segment_tree&& other) noexcept = default;
+  ~segment_tree() = default;
+
+  segment_tree& operator=(const segment_tree& other);
+  segment_tree& operator=(segment_tree&& other) noexcept = default;
+
+  size_type size() const noexcept { return count_; }
+  bool empty() const noexcept { return !count_; }
+  bool lazy() const noexcept { return static_cast<bool>(lazy_); }
+
+  value_type get(size_type pos);
+  void set(size_type pos, const value_type& value);
+  value_type query(size_type first, size_type last);
+  value_type all() const { return tree_.data()[1]; }
+  void range_add(size_type first, size_type last, const value_type& delta);
+
+ private:
+  // Bottom-up layout over a power-of-two leaf count: node k has children 2k
+  // and 2k + 1, leaves start at leaves_. Lazy tags are additive deltas and
+  // are only allocated once range_add() is first used.
+  void pull(size_type k) {
+    value_type* tree = tree_.data();
+    tree[k] = op_(tree[2 * k], tree[2 * k + 1]);
+  }
+  size_type length(size_type k) const noexcept {
+    return leaves_ >> (63 - __builtin_clzll(k));
+  }
+  void apply(size_type k, const value_type& delta);
+  void push(size_type k);
+  void push_path(size_type leaf);
+  void check(size_type first, size_type last) const;
+
+  size_type count_;
+  size_type leaves_{1};
+  int depth_{0};
+  Op op_{};
+  Vector<value_type> tree_;
+  std::unique_ptr<value_type[]> lazy_;
+};
+
+template <typename T, typename Op>
+segment_tree<T, Op>::segment_tree(size_type count) : count_(count) {
+  while (leaves_ < count_) {
+    leaves_ <<= 1;
+    ++depth_;
+  }
+  tree_ = Vector<value_type>(2 * leaves_, Op::identity());
+}
+
+template <typename T, typename Op>
+segment_tree<T, Op>::segment_tree(const Vector<value_type>& values)
+    : segment_tree(values.size()) {
+  std::copy_n(values.data(), count_, tree_.data() + leaves_);
+  for (size_type k = leaves_ - 1; k; --k) {
+    pull(k);
+  }
+}
+
+template <typename T, typename Op>
+segment_tree<T, Op>::segment_tree(const segment_tree& other)
+    : count_(other.count_),
+      leaves_(other.leaves_),
+      depth_(other.depth_),
+      op_(other.op_),
+      tree_(other.tree_) {
+  if (other.lazy_) {
+    lazy_.reset(new value_type[leaves_]);
+    std::copy_n(other.lazy_.get(), leaves_, lazy_.get());
+  }
+}
+
+template <typename T, typename Op>
+segment_tree<T, Op>& segment_tree<T, Op>::operator=(
+    const segment_tree& other) {
+  if (this != &other) {
+    segment_tree tmp{other};
+    *this = std::move(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::check(size_type first, size_type last) const {
+  if (first > last || last > count_) {
+    throw std::out_of_range("Error: segment_tree range out of bounds");
+  }
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::apply(size_type k, const value_type& delta) {
+  value_type* tree = tree_.data();
+  tree[k] = Op::apply(tree[k], delta, length(k));
+  if (k < leaves_) {
+    lazy_[k] += delta;
+  }
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::push(size_type k) {
+  if (lazy_[k] == value_type{}) return;
+  apply(2 * k, lazy_[k]);
+  apply(2 * k + 1, lazy_[k]);
+  lazy_[k] = value_type{};
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::push_path(size_type leaf) {
+  if (!lazy_) return;
+  for (int i = depth_; i > 0; --i) {
+    push(leaf >> i);
+  }
+}
+
+template <typename T, typename Op>
+typename segment_tree<T, Op>::value_type segment_tree<T, Op>::get(
+    size_type pos) {
+  check(pos, pos + 1);
+  push_path(pos + leaves_);
+  return tree_.data()[pos + leaves_];
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::set(size_type pos, const value_type& value) {
+  check(pos, pos + 1);
+  size_type leaf = pos + leaves_;
+  push_path(leaf);
+  tree_.data()[leaf] = value;
+  for (int i = 1; i <= depth_; ++i) {
+    pull(leaf >> i);
+  }
+}
+
+template <typename T, typename Op>
+typename segment_tree<T, Op>::value_type segment_tree<T, Op>::query(
+    size_type first, size_type last) {
+  check(first, last);
+  if (first == last) return Op::identity();
+
+  first += leaves_;
+  last += leaves_;
+  if (lazy_) {
+    for (int i = depth_; i > 0; --i) {
+      if (((first >> i) << i) != first) push(first >> i);
+      if (((last >> i) << i) != last) push((last - 1) >> i);
+    }
+  }
+
+  const value_type* tree = tree_.data();
+  value_type left = Op::identity();
+  value_type right = Op::identity();
+  for (; first < last; first >>= 1, last >>= 1) {
+    if (first & 1) left = op_(left, tree[first++]);
+    if (last & 1) right = op_(tree[--last], right);
+  }
+  return op_(left, right);
+}
+
+template <typename T, typename Op>
+void segment_tree<T, Op>::range_add(size_type first, size_type last,
+                                    const value_type& delta) {
+  check(first, last);
+  if (first == last) return;
+  if (!lazy_) {
+    lazy_.reset(new value_type[leaves_]());
+  }
+
+  first += leaves_;
+  last += leaves_;
+  for (int i = depth_; i > 0; --i) {
+    if (((first >> i) << i) != first) push(first >> i);
+    if (((last >> i) << i) != last) push((last - 1) >> i);
+  }
+
+  for (size_type l = first, r = last; l < r; l >>= 1, r >>= 1) {
+    if (l & 1) apply(l++, delta);
+    if (r & 1) apply(--r, delta);
+  }
+
+  for (int i = 1; i <= depth_; ++i) {
+    if (((first >> i) << i) != first) pull(first >> i);
+    if (((last >> i) << i) != last) pull((last - 1) >> i);
+  }
+}
+
+}
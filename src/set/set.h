@@ -1,11 +1,12 @@
-#include "hash_table.h"
+#include "small_table.h"
 
 namespace containers {
 
-template <typename K, typename H = std::hash<K>>
+template <typename K, typename H = fast_hash<K>,
+          size_t N = default_small_size>
 class Set {
  public:
-  using table = hash_table<K, K, H>;
+  using table = small_table<K, K, H, N>;
   using key_type = K;
   using mapped_type = K;
   using value_type = std::pair<key_type, mapped_type>;
@@ -35,6 +36,13 @@ class Set {
   size_type size() const noexcept { return t.size(); }
 
   void clear() { t.clear(); }
+  void shrink_to_fit() { t.shrink_to_fit(); }
+  void set_min_load_factor(double factor) noexcept {
+    t.set_min_load_factor(factor);
+  }
+  void set_incremental_rehash(bool enabled) noexcept {
+    t.set_incremental_rehash(enabled);
+  }
   std::pair<iterator, bool> insert(const mapped_type& value) {
     value_type p = {value, value};
     return t.insert(p);
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace containers {
+
+struct slot_handle {
+  uint32_t index;
+  uint32_t generation;
+
+  friend bool operator==(const slot_handle& a, const slot_handle& b) noexcept {
+    return a.index == b.index && a.generation == b.generation;
+  }
+  friend bool operator!=(const slot_handle& a, const slot_handle& b) noexcept {
+    return !(a == b);
+  }
+};
+
+template <typename T>
+class slot_map {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using handle = slot_handle;
+  using size_type = size_t;
+
+  slot_map() = default;
+  slot_map(const slot_map& other) = default;
+  slot_map(slot_map&& other) noexcept;
+  ~slot_map() = default;
+
+  slot_map& operator=(const slot_map& other);
+  slot_map& operator=(slot_map&& other) noexcept;
+
+  size_type size() const noexcept { return values_.size(); }
+  bool empty() const noexcept { return !size(); }
+  size_type slot_count() const noexcept { return slots_.size(); }
+  void reserve(size_type count);
+  void clear();
+
+  iterator begin() noexcept { return values_.data(); }
+  iterator end() noexcept { return values_.data() + size(); }
+  const_iterator begin() const noexcept { return values_.data(); }
+  const_iterator end() const noexcept { return values_.data() + size(); }
+  pointer data() noexcept { return values_.data(); }
+  const_pointer data() const noexcept { return values_.data(); }
+
+  handle insert(const_reference value);
+  template <typename... Args>
+  handle emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  bool erase(handle h);
+
+  bool contains(handle h) const noexcept { return find(h); }
+  pointer find(handle h) noexcept;
+  const_pointer find(handle h) const noexcept;
+  reference at(handle h);
+  const_reference at(handle h) const;
+  reference operator[](handle h) noexcept { return *find(h); }
+  const_reference operator[](handle h) const noexcept { return *find(h); }
+
+  handle handle_of(const_iterator pos) const noexcept;
+  void swap(slot_map& other) noexcept;
+
+ private:
+  static constexpr uint32_t null_slot = UINT32_MAX;
+
+  // A live slot stores the dense index of its value; a free slot stores the
+  // next free slot. The generation is bumped on every insert and erase, so
+  // it is odd while the slot is live and even while it is free, and no
+  // handle can validate against a free slot.
+  struct slot {
+    uint32_t target;
+    uint32_t generation;
+  };
+
+  Vector<slot> slots_;
+  Vector<value_type> values_;
+  Vector<uint32_t> owners_;
+  uint32_t free_head_{null_slot};
+};
+
+template <typename T>
+slot_map<T>::slot_map(slot_map&& other) noexcept
+    : slots_(std::move(other.slots_)),
+      values_(std::move(other.values_)),
+      owners_(std::move(other.owners_)),
+      free_head_(other.free_head_) {
+  other.free_head_ = null_slot;
+}
+
+template <typename T>
+slot_map<T>& slot_map<T>::operator=(const slot_map& other) {
+  if (this != &other) {
+    slot_map tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T>
+slot_map<T>& slot_map<T>::operator=(slot_map&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename T>
+void slot_map<T>::reserve(size_type count) {
+  slots_.reserve(count);
+  values_.reserve(count);
+  owners_.reserve(count);
+}
+
+template <typename T>
+void slot_map<T>::clear() {
+  for (size_type i = 0; i < owners_.size(); ++i) {
+    slot& s = slots_.data()[owners_.data()[i]];
+    ++s.generation;
+    s.target = free_head_;
+    free_head_ = owners_.data()[i];
+    values_.data()[i] = value_type{};
+  }
+  values_.clear();
+  owners_.clear();
+}
+
+template <typename T>
+typename slot_map<T>::handle slot_map<T>::insert(const_reference value) {
+  uint32_t index = free_head_;
+  if (index == null_slot) {
+    if (slots_.size() >= null_slot) {
+      throw std::out_of_range("Error: slot_map is full");
+    }
+    index = static_cast<uint32_t>(slots_.size());
+    slots_.push_back(slot{null_slot, 0});
+  } else {
+    free_head_ = slots_.data()[index].target;
+  }
+
+  values_.push_back(value);
+  owners_.push_back(index);
+  slot& s = slots_.data()[index];
+  s.target = static_cast<uint32_t>(values_.size() - 1);
+  ++s.generation;
+  return handle{index, s.generation};
+}
+
+template <typename T>
+bool slot_map<T>::erase(handle h) {
+  if (!contains(h)) return false;
+
+  slot& s = slots_.data()[h.index];
+  uint32_t dense = s.target;
+  uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+  if (dense != last) {
+    values_.data()[dense] = std::move(values_.data()[last]);
+    owners_.data()[dense] = owners_.data()[last];
+    slots_.data()[owners_.data()[dense]].target = dense;
+  }
+  values_.data()[last] = value_type{};
+  values_.pop_back();
+  owners_.pop_back();
+
+  ++s.generation;
+  s.target = free_head_;
+  free_head_ = h.index;
+  return true;
+}
+
+template <typename T>
+typename slot_map<T>::pointer slot_map<T>::find(handle h) noexcept {
+  return const_cast<pointer>(std::as_const(*this).find(h));
+}
+
+template <typename T>
+typename slot_map<T>::const_pointer slot_map<T>::find(handle h) const
+    noexcept {
+  if (h.index >= slots_.size()) return nullptr;
+
+  const slot& s = slots_.data()[h.index];
+  if (s.generation != h.generation || !(s.generation & 1)) return nullptr;
+  return values_.data() + s.target;
+}
+
+template <typename T>
+typename slot_map<T>::reference slot_map<T>::at(handle h) {
+  pointer value = find(h);
+  if (!value) {
+    throw std::out_of_range("Error: stale or invalid slot_map handle");
+  }
+  return *value;
+}
+
+template <typename T>
+typename slot_map<T>::const_reference slot_map<T>::at(handle h) const {
+  const_pointer value = find(h);
+  if (!value) {
+    throw std::out_of_range("Error: stale or invalid slot_map handle");
+  }
+  return *value;
+}
+
+template <typename T>
+typename slot_map<T>::handle slot_map<T>::handle_of(
+    const_iterator pos) const noexcept {
+  uint32_t index = owners_.data()[pos - begin()];
+  return handle{index, slots_.data()[index].generation};
+}
+
+template <typename T>
+void slot_map<T>::swap(slot_map& other) noexcept {
+  slots_.swap(other.slots_);
+  values_.swap(other.values_);
+  owners_.swap(other.owners_);
+  std::swap(free_head_, other.free_head_);
+}
+
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "fast_hash.h"
+
+namespace containers {
+
+// Strings of up to N characters live inside the object. The last inline byte
+// holds N - size, so a full inline string doubles as its own terminator, and
+// a heap string marks it with heap_flag. Unused inline bytes are kept zero,
+// which lets two inline strings compare as whole words.
+template <size_t N>
+class basic_small_string {
+ public:
+  using value_type = char;
+  using reference = char&;
+  using const_reference = const char&;
+  using pointer = char*;
+  using const_pointer = const char*;
+  using iterator = char*;
+  using const_iterator = const char*;
+  using size_type = size_t;
+
+  static constexpr size_type inline_capacity = N;
+
+  basic_small_string() noexcept { reset(); }
+  basic_small_string(const char* value)
+      : basic_small_string(std::string_view(value)) {}
+  basic_small_string(const char* value, size_type count)
+      : basic_small_string(std::string_view(value, count)) {}
+  explicit basic_small_string(std::string_view value);
+  basic_small_string(size_type count, char ch);
+  basic_small_string(const basic_small_string& other)
+      : basic_small_string(other.view()) {}
+  basic_small_string(basic_small_string&& other) noexcept;
+  ~basic_small_string() { release(); }
+
+  basic_small_string& operator=(const basic_small_string& other);
+  basic_small_string& operator=(basic_small_string&& other) noexcept;
+  basic_small_string& operator=(std::string_view value) {
+    return assign(value);
+  }
+  basic_small_string& operator=(const char* value) {
+    return assign(value);
+  }
+
+  size_type size() const noexcept {
+    return is_inline() ? N - static_cast<unsigned char>(bytes_[N])
+                       : heap_.size;
+  }
+  size_type length() const noexcept { return size(); }
+  size_type capacity() const noexcept {
+    return is_inline() ? N : heap_capacity();
+  }
+  bool empty() const noexcept { return !size(); }
+  bool is_inline() const noexcept {
+    return static_cast<unsigned char>(bytes_[N]) != heap_flag;
+  }
+
+  pointer data() noexcept { return is_inline() ? bytes_ : heap_.data; }
+  const_pointer data() const noexcept {
+    return is_inline() ? bytes_ : heap_.data;
+  }
+  const_pointer c_str() const noexcept { return data(); }
+  std::string_view view() const noexcept { return {data(), size()}; }
+  operator std::string_view() const noexcept { return view(); }
+  std::string str() const { return std::string(data(), size()); }
+
+  iterator begin() noexcept { return data(); }
+  iterator end() noexcept { return data() + size(); }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + size(); }
+
+  reference operator[](size_type pos) noexcept { return data()[pos]; }
+  const_reference operator[](size_type pos) const noexcept {
+    return data()[pos];
+  }
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference front() noexcept { return data()[0]; }
+  reference back() noexcept { return data()[size() - 1]; }
+
+  void clear() noexcept;
+  void reserve(size_type new_cap);
+  void resize(size_type count, char ch = '\0');
+  void push_back(char ch);
+  void pop_back() noexcept;
+  basic_small_string& assign(std::string_view value);
+  basic_small_string& append(std::string_view value);
+  basic_small_string& operator+=(std::string_view value) {
+    return append(value);
+  }
+  basic_small_string& operator+=(char ch) {
+    push_back(ch);
+    return *this;
+  }
+  void swap(basic_small_string& other) noexcept;
+
+  friend bool operator==(const basic_small_string& a,
+                         const basic_small_string& b) noexcept {
+    if (a.is_inline() && b.is_inline()) return a.same_words(b);
+    return a.view() == b.view();
+  }
+  friend bool operator!=(const basic_small_string& a,
+                         const basic_small_string& b) noexcept {
+    return !(a == b);
+  }
+  friend bool operator==(const basic_small_string& a,
+                         std::string_view b) noexcept {
+    return a.view() == b;
+  }
+  friend bool operator==(std::string_view a,
+                         const basic_small_string& b) noexcept {
+    return a == b.view();
+  }
+  friend bool operator!=(const basic_small_string& a,
+                         std::string_view b) noexcept {
+    return a.view() != b;
+  }
+  friend bool operator!=(std::string_view a,
+                         const basic_small_string& b) noexcept {
+    return a != b.view();
+  }
+  friend bool operator==(const basic_small_string& a, const char* b) noexcept {
+    return a.view() == b;
+  }
+  friend bool operator!=(const basic_small_string& a, const char* b) noexcept {
+    return a.view() != b;
+  }
+  friend bool operator<(const basic_small_string& a,
+                        const basic_small_string& b) noexcept {
+    return a.view() < b.view();
+  }
+  friend bool operator>(const basic_small_string& a,
+                        const basic_small_string& b) noexcept {
+    return b < a;
+  }
+  friend bool operator<=(const basic_small_string& a,
+                         const basic_small_string& b) noexcept {
+    return !(b < a);
+  }
+  friend bool operator>=(const basic_small_string& a,
+                         const basic_small_string& b) noexcept {
+    return !(a < b);
+  }
+
+ private:
+  struct heap_rep {
+    char* data;
+    size_type size;
+  };
+
+  static_assert(N >= sizeof(heap_rep) && N < 128,
+                "small_string inline capacity must fit the heap header");
+
+  static constexpr unsigned char heap_flag = 0x80;
+  static constexpr size_type header = sizeof(size_type);
+
+  size_type heap_capacity() const noexcept {
+    size_type cap;
+    std::memcpy(&cap, heap_.data - header, sizeof(cap));
+    return cap;
+  }
+  void reset() noexcept {
+    std::memset(bytes_, 0, sizeof(bytes_));
+    bytes_[N] = static_cast<char>(N);
+  }
+  void set_size(size_type count) noexcept;
+  void release() noexcept {
+    if (!is_inline()) delete[] (heap_.data - header);
+  }
+  bool same_words(const basic_small_string& other) const noexcept;
+  void grow(size_type new_cap);
+
+  union {
+    heap_rep heap_;
+    char bytes_[N + 1];
+  };
+};
+
+using small_string = basic_small_string<23>;
+
+template <size_t N>
+basic_small_string<N>::basic_small_string(std::string_view value) {
+  reset();
+  append(value);
+}
+
+template <size_t N>
+basic_small_string<N>::basic_small_string(size_type count, char ch) {
+  reset();
+  resize(count, ch);
+}
+
+template <size_t N>
+basic_small_string<N>::basic_small_string(basic_small_string&& other) noexcept {
+  std::memcpy(static_cast<void*>(this), &other, sizeof(*this));
+  other.reset();
+}
+
+template <size_t N>
+basic_small_string<N>& basic_small_string<N>::operator=(
+    const basic_small_string& other) {
+  if (this != &other) {
+    assign(other.view());
+  }
+  return *this;
+}
+
+template <size_t N>
+basic_small_string<N>& basic_small_string<N>::operator=(
+    basic_small_string&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <size_t N>
+void basic_small_string<N>::swap(basic_small_string& other) noexcept {
+  basic_small_string tmp(std::move(other));
+  std::memcpy(static_cast<void*>(&other), this, sizeof(*this));
+  std::memcpy(static_cast<void*>(this), &tmp, sizeof(*this));
+  tmp.reset();
+}
+
+template <size_t N>
+bool basic_small_string<N>::same_words(
+    const basic_small_string& other) const noexcept {
+  constexpr size_type words = (N + 1) / sizeof(uint64_t);
+  for (size_type i = 0; i < words; ++i) {
+    uint64_t a, b;
+    std::memcpy(&a, bytes_ + i * sizeof(a), sizeof(a));
+    std::memcpy(&b, other.bytes_ + i * sizeof(b), sizeof(b));
+    if (a != b) return false;
+  }
+  return std::memcmp(bytes_ + words * sizeof(uint64_t),
+                     other.bytes_ + words * sizeof(uint64_t),
+                     N + 1 - words * sizeof(uint64_t)) == 0;
+}
+
+template <size_t N>
+void basic_small_string<N>::set_size(size_type count) noexcept {
+  if (is_inline()) {
+    size_type old = size();
+    if (count < old) {
+      std::memset(bytes_ + count, 0, old - count);
+    }
+    bytes_[N] = static_cast<char>(N - count);
+  } else {
+    heap_.size = count;
+    heap_.data[count] = '\0';
+  }
+}
+
+template <size_t N>
+void basic_small_string<N>::grow(size_type new_cap) {
+  char* block = nullptr;
+  try {
+    block = new char[header + new_cap + 1];
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+  std::memcpy(block, &new_cap, sizeof(new_cap));
+
+  size_type count = size();
+  std::memcpy(block + header, data(), count);
+  block[header + count] = '\0';
+  release();
+  heap_.data = block + header;
+  heap_.size = count;
+  bytes_[N] = static_cast<char>(heap_flag);
+}
+
+template <size_t N>
+void basic_small_string<N>::reserve(size_type new_cap) {
+  if (new_cap > capacity()) {
+    grow(new_cap);
+  }
+}
+
+template <size_t N>
+void basic_small_string<N>::clear() noexcept {
+  set_size(0);
+}
+
+template <size_t N>
+void basic_small_string<N>::resize(size_type count, char ch) {
+  size_type old = size();
+  if (count > capacity()) {
+    grow(std::max(count, capacity() * 2));
+  }
+  if (count > old) {
+    std::memset(data() + old, ch, count - old);
+  }
+  set_size(count);
+}
+
+template <size_t N>
+void basic_small_string<N>::push_back(char ch) {
+  size_type count = size();
+  if (count == capacity()) {
+    grow(capacity() * 2);
+  }
+  data()[count] = ch;
+  set_size(count + 1);
+}
+
+template <size_t N>
+void basic_small_string<N>::pop_back() noexcept {
+  set_size(size() - 1);
+}
+
+template <size_t N>
+basic_small_string<N>& basic_small_string<N>::assign(std::string_view value) {
+  if (value.size() > capacity()) {
+    grow(value.size());
+  }
+  // The source may alias this string, so move rather than copy.
+  std::memmove(data(), value.data(), value.size());
+  set_size(value.size());
+  return *this;
+}
+
+template <size_t N>
+basic_small_string<N>& basic_small_string<N>::append(std::string_view value) {
+  size_type count = size();
+  if (count + value.size() > capacity()) {
+    if (value.data() >= data() && value.data() <= data() + count) {
+      basic_small_string copy(value);
+      return append(copy.view());
+    }
+    grow(std::max(count + value.size(), capacity() * 2));
+  }
+  std::memmove(data() + count, value.data(), value.size());
+  set_size(count + value.size());
+  return *this;
+}
+
+template <size_t N>
+typename basic_small_string<N>::reference basic_small_string<N>::at(
+    size_type pos) {
+  if (pos >= size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  return data()[pos];
+}
+
+template <size_t N>
+typename basic_small_string<N>::const_reference basic_small_string<N>::at(
+    size_type pos) const {
+  if (pos >= size()) {
+    throw std::out_of_range("Error: index is out of range");
+  }
+  return data()[pos];
+}
+
+template <size_t N>
+struct fast_hash<basic_small_string<N>> {
+  size_t operator()(const basic_small_string<N>& key) const noexcept {
+    return hash_bytes(key.data(), key.size());
+  }
+};
+
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector.h"
+
+namespace containers {
+
+template <typename T>
+class sparse_set {
+  static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>,
+                "sparse_set requires unsigned integral ids");
+
+ public:
+  using value_type = T;
+  using key_type = T;
+  using const_reference = const T&;
+  using const_pointer = const T*;
+  using iterator = const T*;
+  using const_iterator = const T*;
+  using size_type = size_t;
+
+  sparse_set() = default;
+  explicit sparse_set(size_type universe) { reserve(universe); }
+  sparse_set(std::initializer_list<value_type> const& items);
+  sparse_set(const sparse_set& other);
+  sparse_set(sparse_set&& other) noexcept;
+  ~sparse_set() = default;
+
+  sparse_set& operator=(const sparse_set& other);
+  sparse_set& operator=(sparse_set&& other) noexcept;
+
+  size_type size() const noexcept { return dense_.size(); }
+  bool empty() const noexcept { return !size(); }
+  size_type universe() const noexcept { return universe_; }
+  void reserve(size_type universe);
+  void clear() noexcept { dense_.clear(); }
+
+  const_iterator begin() const noexcept { return dense_.data(); }
+  const_iterator end() const noexcept { return dense_.data() + size(); }
+  const_pointer data() const noexcept { return dense_.data(); }
+
+  bool insert(value_type id);
+  bool erase(value_type id) noexcept;
+  bool contains(value_type id) const noexcept;
+  size_type index_of(value_type id) const;
+  void swap(sparse_set& other) noexcept;
+
+ private:
+  // Stale sparse entries are harmless: membership is confirmed by the dense
+  // array pointing back at the id, which is what makes clear() O(1).
+  Vector<value_type> dense_;
+  std::unique_ptr<value_type[]> sparse_;
+  size_type universe_{0};
+};
+
+template <typename T>
+sparse_set<T>::sparse_set(std::initializer_list<value_type> const& items) {
+  for (auto& it : items) {
+    insert(it);
+  }
+}
+
+template <typename T>
+sparse_set<T>::sparse_set(const sparse_set& other)
+    : dense_(other.dense_), universe_(other.universe_) {
+  if (universe_) {
+    sparse_.reset(new value_type[universe_]);
+    std::copy_n(other.sparse_.get(), universe_, sparse_.get());
+  }
+}
+
+template <typename T>
+sparse_set<T>::sparse_set(sparse_set&& other) noexcept
+    : dense_(std::move(other.dense_)),
+      sparse_(std::move(other.sparse_)),
+      universe_(other.universe_) {
+  other.universe_ = 0;
+}
+
+template <typename T>
+sparse_set<T>& sparse_set<T>::operator=(const sparse_set& other) {
+  if (this != &other) {
+    sparse_set tmp{other};
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T>
+sparse_set<T>& sparse_set<T>::operator=(sparse_set&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename T>
+void sparse_set<T>::reserve(size_type universe) {
+  if (universe <= universe_) return;
+
+  std::unique_ptr<value_type[]> sparse;
+  try {
+    sparse.reset(new value_type[universe]());
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+  if (universe_) {
+    std::copy_n(sparse_.get(), universe_, sparse.get());
+  }
+  sparse_ = std::move(sparse);
+  universe_ = universe;
+}
+
+template <typename T>
+bool sparse_set<T>::contains(value_type id) const noexcept {
+  if (id >= universe_) return false;
+  size_type index = sparse_[id];
+  return index < size() && dense_.data()[index] == id;
+}
+
+template <typename T>
+bool sparse_set<T>::insert(value_type id) {
+  if (contains(id)) return false;
+
+  if (id >= universe_) {
+    reserve(std::max<size_type>(size_type{id} + 1, universe_ * 2));
+  }
+  sparse_[id] = static_cast<value_type>(size());
+  dense_.push_back(id);
+  return true;
+}
+
+template <typename T>
+bool sparse_set<T>::erase(value_type id) noexcept {
+  if (!contains(id)) return false;
+
+  value_type last = dense_.data()[size() - 1];
+  dense_.data()[sparse_[id]] = last;
+  sparse_[last] = sparse_[id];
+  dense_.pop_back();
+  return true;
+}
+
+template <typename T>
+typename sparse_set<T>::size_type sparse_set<T>::index_of(
+    value_type id) const {
+  if (!contains(id)) {
+    throw std::out_of_range("Error: id is not in the sparse_set");
+  }
+  return sparse_[id];
+}
+
+template <typename T>
+void sparse_set<T>::swap(sparse_set& other) noexcept {
+  dense_.swap(other.dense_);
+  sparse_.swap(other.sparse_);
+  std::swap(universe_, other.universe_);
+}
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace containers {
+
+constexpr size_t default_lockfree_chunk = 1024;
+
+template <typename T, size_t ChunkSize = default_lockfree_chunk>
+class lockfree_stack {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+  static constexpr size_type max_chunks = 4096;
+
+  static_assert(ChunkSize > 0, "lockfree_stack chunk size must be positive");
+  static_assert(uint64_t{max_chunks} * ChunkSize < UINT32_MAX,
+                "lockfree_stack node indices must fit in 32 bits");
+
+  lockfree_stack() = default;
+  explicit lockfree_stack(size_type capacity) { reserve(capacity); }
+  lockfree_stack(const lockfree_stack& other) = delete;
+  lockfree_stack(lockfree_stack&& other) = delete;
+  ~lockfree_stack();
+
+  lockfree_stack& operator=(const lockfree_stack& other) = delete;
+  lockfree_stack& operator=(lockfree_stack&& other) = delete;
+
+  bool empty() const noexcept {
+    return index_of(head_.load(std::memory_order_acquire)) == null_index;
+  }
+  size_type capacity() const noexcept {
+    return chunk_count_.load(std::memory_order_acquire) * ChunkSize;
+  }
+  void reserve(size_type count);
+
+  void push(const_reference value) { emplace(value); }
+  void push(value_type&& value) { emplace(std::move(value)); }
+  template <typename... Args>
+  void emplace(Args&&... args);
+
+  bool pop(reference value);
+  Vector<value_type> pop_all();
+
+ private:
+  // Heads pack a 32-bit node index with a 32-bit tag that changes on every
+  // successful exchange, so a recycled node cannot satisfy a stale CAS.
+  using head_type = uint64_t;
+
+  static constexpr uint32_t null_index = UINT32_MAX;
+
+  struct node {
+    std::atomic<uint32_t> next{null_index};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  static head_type pack(uint32_t index, head_type previous) noexcept {
+    return (((previous >> 32) + 1) << 32) | index;
+  }
+  static uint32_t index_of(head_type head) noexcept {
+    return static_cast<uint32_t>(head);
+  }
+
+  node& at(uint32_t index) const noexcept {
+    return chunks_[index / ChunkSize].load(std::memory_order_acquire)
+        [index % ChunkSize];
+  }
+  void push_chain(std::atomic<head_type>& head, uint32_t first,
+                  uint32_t last) noexcept;
+  uint32_t pop_node(std::atomic<head_type>& head) noexcept;
+  uint32_t allocate_node();
+  void add_chunk();
+
+  alignas(cache_line_size) std::atomic<head_type> head_{null_index};
+  alignas(cache_line_size) std::atomic<head_type> free_{null_index};
+  alignas(cache_line_size) std::atomic<size_type> chunk_count_{0};
+  std::mutex grow_lock_;
+  std::atomic<node*> chunks_[max_chunks]{};
+};
+
+template <typename T, size_t C>
+lockfree_stack<T, C>::~lockfree_stack() {
+  for (uint32_t i = index_of(head_.load(std::memory_order_relaxed));
+       i != null_index; i = at(i).next.load(std::memory_order_relaxed)) {
+    at(i).value()->~T();
+  }
+
+  size_type chunks = chunk_count_.load(std::memory_order_relaxed);
+  for (size_type i = 0; i < chunks; ++i) {
+    delete[] chunks_[i].load(std::memory_order_relaxed);
+  }
+}
+
+template <typename T, size_t C>
+void lockfree_stack<T, C>::push_chain(std::atomic<head_type>& head,
+                                      uint32_t first, uint32_t last) noexcept {
+  head_type old = head.load(std::memory_order_relaxed);
+  do {
+    at(last).next.store(index_of(old), std::memory_order_relaxed);
+  } while (!head.compare_exchange_weak(old, pack(first, old),
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed));
+}
+
+template <typename T, size_t C>
+uint32_t lockfree_stack<T, C>::pop_node(
+    std::atomic<head_type>& head) noexcept {
+  head_type old = head.load(std::memory_order_acquire);
+  while (index_of(old) != null_index) {
+    uint32_t next = at(index_of(old)).next.load(std::memory_order_relaxed);
+    if (head.compare_exchange_weak(old, pack(next, old),
+                                   std::memory_order_acquire,
+                                   std::memory_order_acquire)) {
+      return index_of(old);
+    }
+  }
+  return null_index;
+}
+
+template <typename T, size_t C>
+void lockfree_stack<T, C>::add_chunk() {
+  size_type count = chunk_count_.load(std::memory_order_relaxed);
+  if (count == max_chunks) {
+    throw std::runtime_error("Error: lockfree_stack node pool exhausted");
+  }
+
+  node* chunk = nullptr;
+  try {
+    chunk = new node[C];
+  } catch (std::bad_alloc& e) {
+    throw std::runtime_error("Error: Failed to allocate memory");
+  }
+
+  uint32_t base = static_cast<uint32_t>(count * C);
+  for (size_type i = 0; i + 1 < C; ++i) {
+    chunk[i].next.store(base + static_cast<uint32_t>(i) + 1,
+                        std::memory_order_relaxed);
+  }
+  chunks_[count].store(chunk, std::memory_order_release);
+  chunk_count_.store(count + 1, std::memory_order_release);
+  push_chain(free_, base, base + static_cast<uint32_t>(C) - 1);
+}
+
+template <typename T, size_t C>
+uint32_t lockfree_stack<T, C>::allocate_node() {
+  for (;;) {
+    uint32_t index = pop_node(free_);
+    if (index != null_index) return index;
+
+    std::lock_guard<std::mutex> guard(grow_lock_);
+    if (index_of(free_.load(std::memory_order_acquire)) == null_index) {
+      add_chunk();
+    }
+  }
+}
+
+template <typename T, size_t C>
+void lockfree_stack<T, C>::reserve(size_type count) {
+  std::lock_guard<std::mutex> guard(grow_lock_);
+  while (capacity() < count) {
+    add_chunk();
+  }
+}
+
+template <typename T, size_t C>
+template <typename... Args>
+void lockfree_stack<T, C>::emplace(Args&&... args) {
+  uint32_t index = allocate_node();
+  try {
+    new (at(index).storage) T(std::forward<Args>(args)...);
+  } catch (...) {
+    push_chain(free_, index, index);
+    throw;
+  }
+  push_chain(head_, index, index);
+}
+
+template <typename T, size_t C>
+bool lockfree_stack<T, C>::pop(reference value) {
+  uint32_t index = pop_node(head_);
+  if (index == null_index) return false;
+
+  T* stored = at(index).value();
+  value = std::move(*stored);
+  stored->~T();
+  push_chain(free_, index, index);
+  return true;
+}
+
+template <typename T, size_t C>
+Vector<typename lockfree_stack<T, C>::value_type>
+lockfree_stack<T, C>::pop_all() {
+  head_type old = head_.load(std::memory_order_acquire);
+  while (!head_.compare_exchange_weak(old, pack(null_index, old),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+  }
+
+  Vector<value_type> result;
+  uint32_t first = index_of(old);
+  uint32_t last = first;
+  for (uint32_t i = first; i != null_index;
+       i = at(i).next.load(std::memory_order_relaxed)) {
+    T* stored = at(i).value();
+    result.push_back(std::move(*stored));
+    stored->~T();
+    last = i;
+  }
+  if (first != null_index) {
+    push_chain(free_, first, last);
+  }
+  return result;
+}
+
+}
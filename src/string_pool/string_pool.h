@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "hash_table.h"
+#include "vector.h"
+
+namespace containers {
+
+constexpr size_t default_string_pool_chunk = 64 * 1024;
+
+class string_pool {
+ public:
+  using id_type = uint32_t;
+  using size_type = size_t;
+
+  static constexpr id_type npos = UINT32_MAX;
+
+  explicit string_pool(size_type chunk_size = default_string_pool_chunk)
+      : chunk_size_(chunk_size ? chunk_size : default_string_pool_chunk) {}
+  string_pool(const string_pool& other) = delete;
+  string_pool(string_pool&& other) noexcept { swap(other); }
+  ~string_pool() { release(); }
+
+  string_pool& operator=(const string_pool& other) = delete;
+  string_pool& operator=(string_pool&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  size_type size() const noexcept { return strings_.size(); }
+  bool empty() const noexcept { return !size(); }
+  size_type bytes() const noexcept { return bytes_; }
+  void clear();
+  void swap(string_pool& other) noexcept;
+
+  id_type intern(std::string_view value);
+  std::string_view store(std::string_view value) {
+    id_type id = intern(value);
+    return strings_.data()[id];
+  }
+
+  id_type find(std::string_view value);
+  bool contains(std::string_view value) const noexcept {
+    return index_.contains(value);
+  }
+
+  std::string_view operator[](id_type id) const noexcept {
+    return strings_.data()[id];
+  }
+  std::string_view at(id_type id) const;
+
+ private:
+  const char* copy(std::string_view value);
+  void release() noexcept;
+
+  size_type chunk_size_{default_string_pool_chunk};
+  char* cursor_{nullptr};
+  size_type left_{0};
+  size_type bytes_{0};
+  Vector<char*> chunks_;
+  Vector<std::string_view> strings_;
+  hash_table<std::string_view, id_type> index_;
+};
+
+inline void string_pool::release() noexcept {
+  for (size_type i = 0; i < chunks_.size(); ++i) {
+    delete[] chunks_.data()[i];
+  }
+}
+
+inline void string_pool::clear() {
+  release();
+  chunks_.clear();
+  strings_.clear();
+  index_.clear();
+  cursor_ = nullptr;
+  left_ = 0;
+  bytes_ = 0;
+}
+
+inline void string_pool::swap(string_pool& other) noexcept {
+  std::swap(chunk_size_, other.chunk_size_);
+  std::swap(cursor_, other.cursor_);
+  std::swap(left_, other.left_);
+  std::swap(bytes_, other.bytes_);
+  chunks_.swap(other.chunks_);
+  strings_.swap(other.strings_);
+  index_.swap(other.index_);
+}
+
+inline const char* string_pool::copy(std::string_view value) {
+  if (value.empty()) return "";
+
+  char* target = nullptr;
+  if (value.size() > left_) {
+    // Strings longer than a quarter chunk get their own block so the
+    // current chunk keeps its free tail. The block is owned here until
+    // chunks_ has taken it.
+    bool own_block = value.size() > chunk_size_ / 4;
+    std::unique_ptr<char[]> block;
+    try {
+      block.reset(new char[own_block ? value.size() : chunk_size_]);
+    } catch (std::bad_alloc& e) {
+      throw std::runtime_error("Error: Failed to allocate memory");
+    }
+    chunks_.push_back(block.get());
+    if (own_block) {
+      target = block.release();
+    } else {
+      cursor_ = block.release();
+      left_ = chunk_size_;
+    }
+  }
+
+  if (!target) {
+    target = cursor_;
+    cursor_ += value.size();
+    left_ -= value.size();
+  }
+  std::memcpy(target, value.data(), value.size());
+  bytes_ += value.size();
+  return target;
+}
+
+inline string_pool::id_type string_pool::intern(std::string_view value) {
+  auto it = index_.find(value);
+  if (it != index_.end()) return it->second;
+
+  if (size() == npos) {
+    throw std::runtime_error("Error: string_pool id space exhausted");
+  }
+  std::string_view stored(copy(value), value.size());
+  id_type id = static_cast<id_type>(size());
+  strings_.push_back(stored);
+  index_.insert(stored, id);
+  return id;
+}
+
+inline string_pool::id_type string_pool::find(std::string_view value) {
+  auto it = index_.find(value);
+  return it != index_.end() ? it->second : npos;
+}
+
+inline std::string_view string_pool::at(id_type id) const {
+  if (id >= size()) {
+    throw std::out_of_range("Error: string id is out of range");
+  }
+  return strings_.data()[id];
+}
+
+}
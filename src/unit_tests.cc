@@ -1,10 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <map>
+#include <mutex>
 #include <queue>
+#include <random>
 #include <set>
+#include <sstream>
 #include <stack>
+#include <thread>
 #include <vector>
 #include <array>
 
@@ -1568,7 +1574,7 @@ TEST(setTest, MoveConstructor) {
 }
 
 TEST(setTest, BeginEnd) {
-  s21::Set<int> s{3, 5, 1, 4, 2};
+  s21::Set<int, std::hash<int>, 0> s{3, 5, 1, 4, 2};
   auto it = s.begin();
   ASSERT_EQ(it->second, 1);
 
@@ -1714,7 +1720,7 @@ TEST(mapTest, EmptyAndSize) {
 }
 
 TEST(mapTest, Erase) {
-  s21::Map<int, std::string> map;
+  s21::Map<int, std::string, std::hash<int>, 0> map;
 
   map.insert({1, "one"});
   map.insert({2, "two"});
@@ -1921,6 +1927,2570 @@ TEST(MapTest, InsertManyRvalueTest) {
   EXPECT_TRUE(value.empty());
 }
 
+TEST(CircularBufferTest, PushBackUntilFull) {
+  containers::circular_buffer<int> buf(3);
+  EXPECT_TRUE(buf.empty());
+  EXPECT_EQ(buf.capacity(), 3U);
+
+  buf.push_back(1);
+  buf.push_back(2);
+  buf.push_back(3);
+
+  EXPECT_TRUE(buf.full());
+  EXPECT_EQ(buf.size(), 3U);
+  EXPECT_EQ(buf.front(), 1);
+  EXPECT_EQ(buf.back(), 3);
+}
+
+TEST(CircularBufferTest, PushBackOverwritesOldest) {
+  containers::circular_buffer<int> buf(3, {1, 2, 3});
+
+  buf.push_back(4);
+  buf.push_back(5);
+
+  EXPECT_EQ(buf.size(), 3U);
+  EXPECT_EQ(buf[0], 3);
+  EXPECT_EQ(buf[1], 4);
+  EXPECT_EQ(buf[2], 5);
+  EXPECT_THROW(buf.at(3), std::out_of_range);
+}
+
+TEST(CircularBufferTest, PushFrontAndPop) {
+  containers::circular_buffer<int> buf(3, {1, 2});
+
+  buf.push_front(0);
+  EXPECT_EQ(buf.front(), 0);
+  EXPECT_EQ(buf.back(), 2);
+
+  buf.pop_front();
+  buf.pop_back();
+  EXPECT_EQ(buf.size(), 1U);
+  EXPECT_EQ(buf.front(), 1);
+
+  buf.pop_back();
+  EXPECT_TRUE(buf.empty());
+  EXPECT_THROW(buf.pop_front(), std::runtime_error);
+}
+
+TEST(CircularBufferTest, ArrayRanges) {
+  containers::circular_buffer<int> buf(4, {1, 2, 3, 4});
+  buf.push_back(5);
+  buf.push_back(6);
+
+  auto one = buf.array_one();
+  auto two = buf.array_two();
+  ASSERT_EQ(one.second, 2U);
+  ASSERT_EQ(two.second, 2U);
+  EXPECT_EQ(one.first[0], 3);
+  EXPECT_EQ(one.first[1], 4);
+  EXPECT_EQ(two.first[0], 5);
+  EXPECT_EQ(two.first[1], 6);
+
+  containers::circular_buffer<int> linear(4, {1, 2});
+  EXPECT_EQ(linear.array_one().second, 2U);
+  EXPECT_EQ(linear.array_two().second, 0U);
+}
+
+TEST(CircularBufferTest, Iterator) {
+  containers::circular_buffer<int> buf(3, {1, 2, 3, 4, 5});
+  std::vector<int> expected = {3, 4, 5};
+
+  std::vector<int> actual(buf.begin(), buf.end());
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ(buf.end() - buf.begin(), 3);
+
+  const auto& cbuf = buf;
+  auto it = cbuf.begin();
+  it += 2;
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(it[-1], 4);
+}
+
+TEST(CircularBufferTest, CopyAndMove) {
+  containers::circular_buffer<std::string> buf(2, {"a", "b", "c"});
+
+  containers::circular_buffer<std::string> copy(buf);
+  EXPECT_EQ(copy.size(), 2U);
+  EXPECT_EQ(copy[0], "b");
+  EXPECT_EQ(copy[1], "c");
+
+  containers::circular_buffer<std::string> moved(std::move(buf));
+  EXPECT_EQ(moved.front(), "b");
+  EXPECT_EQ(buf.capacity(), 0U);
+
+  buf = copy;
+  EXPECT_EQ(buf.back(), "c");
+  buf.clear();
+  EXPECT_TRUE(buf.empty());
+  EXPECT_EQ(buf.capacity(), 2U);
+}
+
+TEST(CircularBufferTest, ClearReleasesElements) {
+  auto value = std::make_shared<int>(1);
+  containers::circular_buffer<std::shared_ptr<int>> buf(3);
+  buf.push_back(value);
+  buf.push_back(value);
+  buf.push_back(value);
+  buf.push_back(value);
+  EXPECT_EQ(value.use_count(), 4);
+  buf.clear();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(VectorAllocatorTest, AlignedVector) {
+  containers::aligned_vector<char> vec(100, 'a');
+  auto address = reinterpret_cast<uintptr_t>(vec.data());
+
+  EXPECT_EQ(address % containers::cache_line_size, 0U);
+  EXPECT_EQ(vec.size(), 100U);
+  EXPECT_EQ(vec[99], 'a');
+}
+
+TEST(VectorAllocatorTest, CustomAlignment) {
+  containers::Vector<int, containers::aligned_allocator<int, 4096>> vec = {
+      1, 2, 3};
+  auto address = reinterpret_cast<uintptr_t>(vec.data());
+
+  EXPECT_EQ(address % 4096, 0U);
+  vec.push_back(4);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.data()) % 4096, 0U);
+  EXPECT_EQ(vec[3], 4);
+}
+
+TEST(VectorAllocatorTest, HugePageVectorBelowThreshold) {
+  containers::huge_page_vector<int> vec(16, 7);
+  auto address = reinterpret_cast<uintptr_t>(vec.data());
+
+  EXPECT_EQ(address % containers::cache_line_size, 0U);
+  EXPECT_EQ(vec.back(), 7);
+}
+
+TEST(VectorAllocatorTest, HugePageVectorAboveThreshold) {
+  size_t count = containers::huge_page_size / sizeof(int) + 1;
+  containers::huge_page_vector<int> vec(count, 3);
+  auto address = reinterpret_cast<uintptr_t>(vec.data());
+
+  EXPECT_EQ(address % containers::huge_page_size, 0U);
+  EXPECT_EQ(vec.size(), count);
+  EXPECT_EQ(vec.front(), 3);
+  EXPECT_EQ(vec.back(), 3);
+
+  vec.push_back(4);
+  EXPECT_EQ(vec.back(), 4);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), count + 1);
+  EXPECT_EQ(vec.back(), 4);
+}
+
+TEST(VectorParallelTest, ParallelFillConstructor) {
+  containers::parallel_policy policy;
+  policy.threads = 4;
+  policy.threshold = 0;
+
+  containers::Vector<int64_t> vec(100003, 42, policy);
+  EXPECT_EQ(vec.size(), 100003U);
+  EXPECT_EQ(std::count(vec.data(), vec.data() + vec.size(), 42),
+            static_cast<std::ptrdiff_t>(vec.size()));
+}
+
+TEST(VectorParallelTest, StreamingFillUnaligned) {
+  containers::parallel_policy policy;
+  policy.threads = 1;
+  policy.threshold = 0;
+
+  containers::Vector<char> vec(1031, 'a');
+  vec.fill('b', policy);
+  EXPECT_EQ(vec.front(), 'b');
+  EXPECT_EQ(vec.back(), 'b');
+  EXPECT_EQ(std::count(vec.data(), vec.data() + vec.size(), 'b'), 1031);
+
+  containers::Vector<char> offset(17, 'x');
+  containers::parallel_fill_n(offset.data() + 1, 15, 'y', policy);
+  EXPECT_EQ(offset[0], 'x');
+  EXPECT_EQ(offset[1], 'y');
+  EXPECT_EQ(offset[15], 'y');
+  EXPECT_EQ(offset[16], 'x');
+}
+
+TEST(VectorParallelTest, ParallelCopy) {
+  containers::parallel_policy policy;
+  policy.threads = 3;
+  policy.threshold = 0;
+
+  containers::Vector<double> source(50001);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source.data()[i] = static_cast<double>(i);
+  }
+
+  containers::Vector<double> copy(source, policy);
+  ASSERT_EQ(copy.size(), source.size());
+  EXPECT_TRUE(std::equal(source.data(), source.data() + source.size(),
+                         copy.data()));
+}
+
+TEST(VectorParallelTest, NonTrivialTypeFallsBack) {
+  containers::parallel_policy policy;
+  policy.threads = 4;
+  policy.threshold = 0;
+
+  containers::Vector<std::string> vec(10, "a", policy);
+  vec.fill("b", policy);
+  containers::Vector<std::string> copy(vec, policy);
+  EXPECT_EQ(copy.size(), 10U);
+  EXPECT_EQ(copy[9], "b");
+}
+
+TEST(VectorParallelTest, ChunksStartOnPages) {
+  containers::parallel_policy policy;
+  policy.threads = 4;
+  std::vector<double> data(20000);
+  const double* base = data.data() + 1;
+  size_t n = data.size() - 1;
+
+  std::mutex lock;
+  std::vector<std::pair<size_t, size_t>> chunks;
+  containers::parallel::for_each_chunk(
+      base, n, policy, [&](size_t begin, size_t count) {
+        std::lock_guard<std::mutex> guard(lock);
+        chunks.emplace_back(begin, count);
+      });
+  std::sort(chunks.begin(), chunks.end());
+
+  ASSERT_GT(chunks.size(), 1U);
+  size_t next = 0;
+  for (auto [begin, count] : chunks) {
+    EXPECT_EQ(begin, next);
+    if (begin != 0) {
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(base + begin) %
+                    containers::parallel::page_size,
+                0U);
+    }
+    next = begin + count;
+  }
+  EXPECT_EQ(next, n);
+
+  policy.threads = 0;
+  size_t covered = 0;
+  containers::parallel::for_each_chunk(
+      base, n, policy, [&](size_t, size_t count) { covered += count; });
+  EXPECT_EQ(covered, n);
+}
+
+TEST(FastHashTest, Deterministic) {
+  containers::fast_hash<std::string> string_hash;
+  containers::fast_hash<std::string_view> view_hash;
+  containers::fast_hash<uint64_t> int_hash;
+
+  EXPECT_EQ(string_hash("hello"), string_hash(std::string("hello")));
+  EXPECT_EQ(string_hash("hello"), view_hash("hello"));
+  EXPECT_NE(string_hash("hello"), string_hash("hellp"));
+  EXPECT_NE(string_hash(""), string_hash(std::string(1, '\0')));
+  EXPECT_EQ(int_hash(42), int_hash(42));
+  EXPECT_NE(int_hash(0), int_hash(1));
+  EXPECT_EQ(containers::fast_hash<double>()(0.0),
+            containers::fast_hash<double>()(-0.0));
+}
+
+TEST(FastHashTest, IntegerAvalanche) {
+  containers::fast_hash<uint64_t> hash;
+  std::mt19937_64 gen(42);
+  const int samples = 2000;
+  std::vector<int> flips(64 * 64);
+
+  for (int s = 0; s < samples; ++s) {
+    uint64_t key = gen();
+    uint64_t h = hash(key);
+    for (int in = 0; in < 64; ++in) {
+      uint64_t diff = h ^ hash(key ^ (uint64_t{1} << in));
+      for (int out = 0; out < 64; ++out) {
+        flips[in * 64 + out] += (diff >> out) & 1;
+      }
+    }
+  }
+
+  for (int count : flips) {
+    double p = static_cast<double>(count) / samples;
+    EXPECT_GT(p, 0.4);
+    EXPECT_LT(p, 0.6);
+  }
+}
+
+TEST(FastHashTest, StringAvalanche) {
+  containers::fast_hash<std::string> hash;
+  std::mt19937_64 gen(7);
+  const int samples = 500;
+
+  for (size_t len : {3, 8, 16, 33, 100}) {
+    std::vector<int> flips(64);
+    int trials = 0;
+    for (int s = 0; s < samples; ++s) {
+      std::string key(len, '\0');
+      for (auto& c : key) c = static_cast<char>(gen());
+      uint64_t h = hash(key);
+      for (size_t bit = 0; bit < len * 8; bit += 7) {
+        std::string flipped = key;
+        flipped[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        uint64_t diff = h ^ hash(flipped);
+        for (int out = 0; out < 64; ++out) {
+          flips[out] += (diff >> out) & 1;
+        }
+        ++trials;
+      }
+    }
+    for (int count : flips) {
+      double p = static_cast<double>(count) / trials;
+      EXPECT_GT(p, 0.45);
+      EXPECT_LT(p, 0.55);
+    }
+  }
+}
+
+TEST(FastHashTest, BucketDistribution) {
+  const size_t buckets = 1024;
+  const size_t keys = buckets * 64;
+  containers::fast_hash<uint64_t> int_hash;
+  containers::fast_hash<std::string> string_hash;
+  std::vector<size_t> int_counts(buckets), string_counts(buckets);
+
+  for (size_t i = 0; i < keys; ++i) {
+    ++int_counts[int_hash(i * buckets) % buckets];
+    ++string_counts[string_hash("key" + std::to_string(i)) % buckets];
+  }
+
+  double expected = static_cast<double>(keys) / buckets;
+  for (auto* counts : {&int_counts, &string_counts}) {
+    double chi = 0;
+    for (size_t count : *counts) {
+      chi += (count - expected) * (count - expected) / expected;
+    }
+    EXPECT_LT(chi, buckets * 1.2);
+  }
+}
+
+TEST(FastHashTest, DefaultHasherForMap) {
+  containers::Map<uint64_t, int> map;
+  for (uint64_t i = 0; i < 100; ++i) {
+    map.insert(i * 1024, static_cast<int>(i));
+  }
+  EXPECT_EQ(map.size(), 100U);
+  EXPECT_TRUE(map.contains(99 * 1024));
+  EXPECT_EQ(map.at(5 * 1024), 5);
+  EXPECT_FALSE(map.contains(1));
+
+  containers::Set<std::string> set = {"a", "b", "c"};
+  EXPECT_TRUE(set.contains("b"));
+  EXPECT_FALSE(set.contains("d"));
+}
+
+TEST(DenseIntMapTest, InsertAndFind) {
+  containers::dense_int_map<uint64_t, uint32_t> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 0U);
+
+  for (uint64_t i = 0; i < 1000; ++i) {
+    auto result = map.insert(i * 7919, static_cast<uint32_t>(i));
+    EXPECT_TRUE(result.second);
+  }
+  EXPECT_EQ(map.size(), 1000U);
+  EXPECT_FALSE(map.insert(7919, 5).second);
+  EXPECT_EQ(map.at(7919), 1U);
+  EXPECT_EQ(map.find(999 * 7919)->second, 999U);
+  EXPECT_EQ(map.find(3), map.end());
+  EXPECT_THROW(map.at(3), std::out_of_range);
+}
+
+TEST(DenseIntMapTest, OperatorBracketAndAssign) {
+  containers::dense_int_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+
+  map[3] = "three";
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map[3], "three");
+
+  auto result = map.insert_or_assign(1, "ONE");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(map.at(1), "ONE");
+}
+
+TEST(DenseIntMapTest, EraseAndReuse) {
+  containers::dense_int_map<uint32_t, int> map;
+  for (uint32_t i = 0; i < 100; ++i) {
+    map[i] = static_cast<int>(i);
+  }
+
+  for (uint32_t i = 0; i < 100; i += 2) {
+    EXPECT_EQ(map.erase(i), 1U);
+  }
+  EXPECT_EQ(map.erase(0), 0U);
+  EXPECT_EQ(map.size(), 50U);
+  EXPECT_FALSE(map.contains(10));
+  EXPECT_TRUE(map.contains(11));
+
+  map.erase(map.find(11));
+  EXPECT_FALSE(map.contains(11));
+
+  for (int round = 0; round < 1000; ++round) {
+    map[1000 + round] = round;
+    map.erase(1000 + round);
+  }
+  EXPECT_EQ(map.size(), 49U);
+  EXPECT_LE(map.capacity(), 256U);
+}
+
+TEST(DenseIntMapTest, SentinelKeys) {
+  using map_type = containers::dense_int_map<uint64_t, int>;
+  map_type map;
+
+  map[map_type::empty_key] = 1;
+  map[map_type::deleted_key] = 2;
+  map[5] = 3;
+
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(map_type::empty_key), 1);
+  EXPECT_EQ(map.at(map_type::deleted_key), 2);
+
+  int sum = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(sum, 6);
+
+  map.erase(map_type::empty_key);
+  EXPECT_FALSE(map.contains(map_type::empty_key));
+  EXPECT_TRUE(map.contains(map_type::deleted_key));
+  EXPECT_EQ(map.size(), 2U);
+}
+
+TEST(DenseIntMapTest, CustomSentinels) {
+  containers::dense_int_map<int32_t, int, -1, -2> map;
+  map[0] = 10;
+  map[-1] = 20;
+  map[std::numeric_limits<int32_t>::max()] = 30;
+
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(-1), 20);
+  EXPECT_EQ(map.at(std::numeric_limits<int32_t>::max()), 30);
+}
+
+TEST(DenseIntMapTest, CopyMoveSwap) {
+  containers::dense_int_map<int, int> map = {{1, 1}, {2, 2}, {3, 3}};
+
+  containers::dense_int_map<int, int> copy(map);
+  copy[4] = 4;
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(copy.size(), 4U);
+
+  containers::dense_int_map<int, int> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 4U);
+  EXPECT_TRUE(copy.empty());
+
+  map.swap(moved);
+  EXPECT_TRUE(map.contains(4));
+  EXPECT_FALSE(moved.contains(4));
+
+  const auto& cmap = map;
+  size_t count = 0;
+  for (auto kv : cmap) {
+    EXPECT_EQ(kv.first, kv.second);
+    ++count;
+  }
+  EXPECT_EQ(count, 4U);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(DenseIntMapTest, InsertMany) {
+  containers::dense_int_map<int, int> map;
+  auto results = map.insert_many(std::make_pair(1, 10), std::make_pair(2, 20),
+                                 std::make_pair(1, 30));
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[2].second);
+  EXPECT_EQ(results[1].first->second, 20);
+  EXPECT_EQ(map.at(1), 10);
+}
+
+TEST(SmallTableTest, StaysInlineUpToSmallSize) {
+  containers::small_table<int, int, containers::fast_hash<int>, 4> table;
+  EXPECT_TRUE(table.is_small());
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.begin(), table.end());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(table.insert(i, i * 10).second);
+  }
+  EXPECT_TRUE(table.is_small());
+  EXPECT_FALSE(table.insert(2, 0).second);
+  EXPECT_EQ(table.at(2), 20);
+  EXPECT_THROW(table.at(5), std::out_of_range);
+
+  table[4] = 40;
+  EXPECT_FALSE(table.is_small());
+  EXPECT_EQ(table.size(), 5U);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(table.at(i), i * 10);
+  }
+
+  table.clear();
+  EXPECT_TRUE(table.is_small());
+  EXPECT_TRUE(table.empty());
+}
+
+TEST(SmallTableTest, EraseInline) {
+  containers::small_table<int, std::string> table;
+  table.insert(1, "one");
+  table.insert(2, "two");
+  table.insert(3, "three");
+
+  table.erase(table.find(2));
+  EXPECT_EQ(table.size(), 2U);
+  EXPECT_FALSE(table.contains(2));
+  EXPECT_EQ(table.at(3), "three");
+
+  std::vector<int> keys;
+  for (auto& kv : table) {
+    keys.push_back(kv.first);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 3}));
+}
+
+TEST(SmallTableTest, SwapMixedModes) {
+  containers::small_table<int, int, containers::fast_hash<int>, 2> small;
+  containers::small_table<int, int, containers::fast_hash<int>, 2> large;
+  small.insert(1, 1);
+  for (int i = 0; i < 10; ++i) {
+    large.insert(i, i);
+  }
+
+  small.swap(large);
+  EXPECT_EQ(small.size(), 10U);
+  EXPECT_FALSE(small.is_small());
+  EXPECT_EQ(large.size(), 1U);
+  EXPECT_TRUE(large.is_small());
+  EXPECT_TRUE(small.contains(9));
+  EXPECT_TRUE(large.contains(1));
+}
+
+TEST(SmallTableTest, MapAcrossThreshold) {
+  containers::Map<std::string, int> map;
+  for (int i = 0; i < 20; ++i) {
+    map.insert_or_assign("key" + std::to_string(i), i);
+  }
+  EXPECT_EQ(map.size(), 20U);
+
+  int sum = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(sum, 190);
+  EXPECT_EQ(map.at("key7"), 7);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains("key7"));
+  map["again"] = 1;
+  EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(SmallTableTest, SetInsertMany) {
+  containers::Set<int> set;
+  auto results = set.insert_many(1, 2, 2, 3);
+  EXPECT_EQ(set.size(), 3U);
+  EXPECT_TRUE(results[1].second);
+  EXPECT_FALSE(results[2].second);
+}
+
+TEST(mapTest, IterateAllBuckets) {
+  containers::Map<int, int, containers::fast_hash<int>, 0> map;
+  for (int i = 0; i < 9; ++i) {
+    map.insert(i, i);
+  }
+
+  int count = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    ++count;
+  }
+  EXPECT_EQ(count, 9);
+
+  auto inserted = map.insert(100, 1);
+  EXPECT_EQ(inserted.first->first, 100);
+  map.erase(inserted.first);
+  EXPECT_FALSE(map.contains(100));
+  EXPECT_EQ(map.size(), 9U);
+}
+
+TEST(HashTableRehashTest, GrowsWithLoad) {
+  containers::hash_table<int, int> table;
+  for (int i = 0; i < 1000; ++i) {
+    table.insert(i, i);
+  }
+
+  EXPECT_EQ(table.size(), 1000U);
+  EXPECT_GE(table.capacity() * 0.7, 1000.0);
+  EXPECT_FALSE(table.rehashing());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(table.contains(i));
+  }
+}
+
+TEST(HashTableRehashTest, IncrementalMigration) {
+  containers::hash_table<int, int> table;
+  table.set_incremental_rehash(true);
+  EXPECT_TRUE(table.incremental_rehash());
+
+  bool seen_rehashing = false;
+  for (int i = 0; i < 5000; ++i) {
+    table[i] = i * 2;
+    seen_rehashing = seen_rehashing || table.rehashing();
+    if (i % 97 == 0) {
+      for (int j = 0; j <= i; j += 13) {
+        ASSERT_TRUE(table.contains(j));
+      }
+    }
+  }
+  EXPECT_TRUE(seen_rehashing);
+  EXPECT_EQ(table.size(), 5000U);
+
+  for (int i = 0; i < 5000; i += 2) {
+    auto it = table.find(i);
+    ASSERT_NE(it, table.end());
+    EXPECT_EQ(it->second, i * 2);
+    table.erase(it);
+  }
+  EXPECT_EQ(table.size(), 2500U);
+  EXPECT_FALSE(table.contains(0));
+  EXPECT_TRUE(table.contains(1));
+  EXPECT_EQ(table.at(4999), 9998);
+}
+
+TEST(HashTableRehashTest, IterationDuringMigration) {
+  containers::hash_table<int, int> table;
+  table.set_incremental_rehash(true);
+  int i = 0;
+  while (!table.rehashing()) {
+    table.insert(i, i);
+    ++i;
+  }
+
+  int count = 0;
+  for (auto it = table.begin(); it != table.end(); ++it) {
+    ++count;
+  }
+  EXPECT_EQ(count, i);
+  EXPECT_TRUE(table.rehashing());
+}
+
+TEST(HashTableRehashTest, FindDuringMigration) {
+  containers::hash_table<int, int> table;
+  table.set_incremental_rehash(true);
+  int size = 0;
+  while (!table.rehashing()) {
+    table.insert(size, size);
+    ++size;
+  }
+
+  for (; table.rehashing(); ++size) {
+    for (int key = 0; key < size; key += 7) {
+      int rest = 0;
+      for (auto it = table.find(key); it != table.end(); ++it) {
+        ++rest;
+      }
+      ASSERT_GE(rest, 1);
+      ASSERT_LE(rest, size);
+    }
+    const auto& view = table;
+    int count = 0;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+      ++count;
+    }
+    ASSERT_EQ(count, size);
+    table.insert(size, size);
+  }
+}
+
+struct counting_hash {
+  static inline size_t calls = 0;
+  size_t operator()(int key) const {
+    ++calls;
+    return containers::fast_hash<int>()(key);
+  }
+};
+
+TEST(HashTableRehashTest, IncrementalInsertWorkIsBounded) {
+  containers::hash_table<int, int, counting_hash> table;
+  table.set_incremental_rehash(true);
+
+  size_t worst = 0;
+  for (int i = 0; i < 200000; ++i) {
+    counting_hash::calls = 0;
+    table.insert(i, i);
+    worst = std::max(worst, counting_hash::calls);
+  }
+  EXPECT_LT(worst, 64U);
+  EXPECT_EQ(table.size(), 200000U);
+  for (int i = 0; i < 200000; i += 101) {
+    ASSERT_EQ(table.at(i), i);
+  }
+}
+
+TEST(HashTableRehashTest, ClearAndSwapDuringMigration) {
+  containers::hash_table<int, int> a;
+  a.set_incremental_rehash(true);
+  for (int i = 0; !a.rehashing(); ++i) {
+    a.insert(i, i);
+  }
+  containers::hash_table<int, int> b;
+  b.insert(-1, -1);
+
+  a.swap(b);
+  EXPECT_TRUE(b.rehashing());
+  EXPECT_TRUE(b.contains(0));
+  EXPECT_TRUE(a.contains(-1));
+
+  b.clear();
+  EXPECT_FALSE(b.rehashing());
+  EXPECT_TRUE(b.empty());
+  b.insert(1, 1);
+  EXPECT_EQ(b.size(), 1U);
+}
+
+TEST(HashTableRehashTest, MapIncrementalRehash) {
+  containers::Map<int, int> map;
+  map.set_incremental_rehash(true);
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i;
+  }
+  map.clear();
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, -i);
+  }
+  EXPECT_EQ(map.size(), 1000U);
+  EXPECT_EQ(map.at(999), -999);
+}
+
+TEST(HashTableShrinkTest, ClearReleasesBuckets) {
+  containers::hash_table<int, int> table;
+  for (int i = 0; i < 1000; ++i) {
+    table.insert(i, i);
+  }
+  table.clear();
+
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.capacity(), 0U);
+  EXPECT_FALSE(table.contains(1));
+  table.insert(1, 1);
+  EXPECT_EQ(table.at(1), 1);
+}
+
+TEST(HashTableShrinkTest, ShrinkToFit) {
+  containers::hash_table<int, int> table;
+  table.set_min_load_factor(0);
+  for (int i = 0; i < 1000; ++i) {
+    table.insert(i, i);
+  }
+  for (int i = 10; i < 1000; ++i) {
+    table.erase(table.find(i));
+  }
+  size_t peak = table.capacity();
+
+  table.shrink_to_fit();
+  EXPECT_LT(table.capacity(), peak);
+  EXPECT_GE(table.capacity() * 0.7, 10.0);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(table.contains(i));
+  }
+
+  table.rehash(500);
+  EXPECT_EQ(table.capacity(), 500U);
+  EXPECT_EQ(table.size(), 10U);
+  table.rehash(1);
+  EXPECT_GE(table.capacity() * 0.7, 10.0);
+}
+
+TEST(HashTableShrinkTest, AutoShrinkOnErase) {
+  containers::hash_table<int, int> table;
+  EXPECT_EQ(table.min_load_factor(), 0.0);
+  table.set_min_load_factor(0.1);
+  for (int i = 0; i < 2000; ++i) {
+    table.insert(i, i);
+  }
+  size_t peak = table.capacity();
+
+  for (int i = 0; i < 1990; ++i) {
+    table.erase(table.find(i));
+  }
+  EXPECT_LT(table.capacity(), peak / 4);
+  EXPECT_EQ(table.size(), 10U);
+  for (int i = 1990; i < 2000; ++i) {
+    EXPECT_EQ(table.at(i), i);
+  }
+}
+
+TEST(HashTableShrinkTest, ShrinkHysteresis) {
+  containers::hash_table<int, int> table;
+  table.set_min_load_factor(0.1);
+  for (int i = 0; i < 1000; ++i) {
+    table.insert(i, i);
+  }
+  for (int i = 0; i < 950; ++i) {
+    table.erase(table.find(i));
+  }
+  size_t shrunk = table.capacity();
+  double load = static_cast<double>(table.size()) / shrunk;
+  EXPECT_GT(load, 0.2);
+  EXPECT_LT(load, 0.6);
+
+  table.insert(-1, -1);
+  table.erase(table.find(-1));
+  EXPECT_EQ(table.capacity(), shrunk);
+}
+
+TEST(HashTableShrinkTest, LargeMinLoadFactorIsClamped) {
+  containers::hash_table<int, int> table;
+  table.set_min_load_factor(0.5);
+  EXPECT_LT(table.min_load_factor(), 0.35);
+  for (int i = 0; i < 2000; ++i) {
+    table.insert(i, i);
+  }
+
+  size_t capacity = table.capacity();
+  int shrinks = 0;
+  for (int i = 0; i < 1990; ++i) {
+    table.erase(table.find(i));
+    ASSERT_LE(table.capacity(), capacity);
+    if (table.capacity() != capacity) {
+      ++shrinks;
+      capacity = table.capacity();
+    }
+  }
+  EXPECT_GT(shrinks, 0);
+  EXPECT_LT(shrinks, 10);
+  EXPECT_EQ(table.at(1995), 1995);
+}
+
+TEST(HashTableShrinkTest, IncrementalShrinkFinishes) {
+  containers::hash_table<int, int> table;
+  table.set_incremental_rehash(true);
+  table.set_min_load_factor(0.1);
+  for (int i = 0; i < 1000; ++i) {
+    table.insert(i, i);
+  }
+  size_t peak = table.capacity();
+  for (int i = 0; i < 950; ++i) {
+    table.erase(table.find(i));
+  }
+  EXPECT_FALSE(table.rehashing());
+  EXPECT_LT(table.capacity(), peak / 4);
+  for (int i = 950; i < 1000; ++i) {
+    EXPECT_EQ(table.at(i), i);
+  }
+
+  containers::hash_table<int, int> other;
+  table.swap(other);
+  EXPECT_EQ(other.min_load_factor(), 0.1);
+  EXPECT_EQ(table.min_load_factor(), 0.0);
+}
+
+TEST(HashTableShrinkTest, EraseWhileIterating) {
+  containers::Map<int, int> map;
+  map.set_incremental_rehash(true);
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, i);
+  }
+
+  for (auto it = map.begin(); it != map.end();) {
+    auto next = it;
+    ++next;
+    if (it->first % 3 != 0) {
+      map.erase(it);
+    }
+    it = next;
+  }
+  EXPECT_EQ(map.size(), 334U);
+  EXPECT_EQ(map.at(999), 999);
+
+  containers::Set<int> set;
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(i);
+  }
+  for (auto it = set.begin(); it != set.end();) {
+    auto next = it;
+    ++next;
+    set.erase(it);
+    it = next;
+  }
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(HashTableShrinkTest, SmallMapReturnsInline) {
+  containers::small_table<int, int, containers::fast_hash<int>, 4> table;
+  for (int i = 0; i < 100; ++i) {
+    table.insert(i, i);
+  }
+  for (int i = 3; i < 100; ++i) {
+    table.erase(table.find(i));
+  }
+  EXPECT_FALSE(table.is_small());
+
+  table.shrink_to_fit();
+  EXPECT_TRUE(table.is_small());
+  EXPECT_EQ(table.size(), 3U);
+  EXPECT_EQ(table.at(2), 2);
+}
+
+TEST(MultisetTest, GroupsEqualKeys) {
+  containers::Multiset<int> ms{3, 1, 3, 2, 3, 1};
+  ASSERT_EQ(ms.size(), 6U);
+  ASSERT_EQ(ms.count(3), 3U);
+  ASSERT_EQ(ms.count(1), 2U);
+  ASSERT_EQ(ms.count(7), 0U);
+
+  auto range = ms.equal_range(3);
+  size_t matches = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ASSERT_EQ(it->first, 3);
+    ++matches;
+  }
+  ASSERT_EQ(matches, 3U);
+
+  auto missing = ms.equal_range(7);
+  ASSERT_TRUE(missing.first == missing.second);
+}
+
+TEST(MultisetTest, Erase) {
+  containers::Multiset<int> ms{5, 5, 6, 5};
+  ms.erase(ms.find(5));
+  ASSERT_EQ(ms.count(5), 2U);
+  ASSERT_EQ(ms.erase(5), 2U);
+  ASSERT_FALSE(ms.contains(5));
+  ASSERT_EQ(ms.size(), 1U);
+  ASSERT_EQ(ms.erase(5), 0U);
+
+  ms.erase(ms.find(6));
+  ASSERT_TRUE(ms.empty());
+}
+
+TEST(MultisetTest, CopyAndMerge) {
+  containers::Multiset<int> a{1, 2, 2};
+  containers::Multiset<int> b{a};
+  b.insert(2);
+  ASSERT_EQ(a.count(2), 2U);
+  ASSERT_EQ(b.count(2), 3U);
+
+  a.merge(b);
+  ASSERT_EQ(a.count(2), 5U);
+  ASSERT_EQ(a.size(), 7U);
+  ASSERT_TRUE(b.empty());
+}
+
+TEST(MultimapTest, EqualRange) {
+  containers::Multimap<int, std::string> mm;
+  mm.insert(1, "a");
+  mm.insert(2, "x");
+  mm.insert(1, "b");
+  mm.insert_many(std::make_pair(1, std::string("c")),
+                 std::make_pair(3, std::string("y")));
+  ASSERT_EQ(mm.size(), 5U);
+  ASSERT_EQ(mm.count(1), 3U);
+
+  std::multiset<std::string> values;
+  auto range = mm.equal_range(1);
+  for (auto it = range.first; it != range.second; ++it) {
+    values.insert(it->second);
+  }
+  ASSERT_EQ(values, (std::multiset<std::string>{"a", "b", "c"}));
+}
+
+TEST(MultimapTest, MatchesStdMultimap) {
+  containers::Multimap<int, int> mm;
+  std::multimap<int, int> expected;
+  std::mt19937 gen(84);
+  for (int i = 0; i < 2000; ++i) {
+    int key = static_cast<int>(gen() % 50);
+    if (gen() % 4 == 0 && mm.contains(key)) {
+      auto it = mm.find(key);
+      auto range = expected.equal_range(key);
+      for (auto e = range.first; e != range.second; ++e) {
+        if (e->second == it->second) {
+          expected.erase(e);
+          break;
+        }
+      }
+      mm.erase(it);
+    } else {
+      mm.insert(key, i);
+      expected.insert({key, i});
+    }
+  }
+
+  ASSERT_EQ(mm.size(), expected.size());
+  for (int key = 0; key < 50; ++key) {
+    ASSERT_EQ(mm.count(key), expected.count(key));
+  }
+
+  size_t total = 0;
+  int prev = -1;
+  std::set<int> seen;
+  for (auto& it : mm) {
+    if (it.first != prev) {
+      ASSERT_TRUE(seen.insert(it.first).second);
+      prev = it.first;
+    }
+    ++total;
+  }
+  ASSERT_EQ(total, expected.size());
+}
+TEST(HyperLogLogTest, SparseSmallCardinality) {
+  containers::hyperloglog<uint64_t> hll;
+  ASSERT_TRUE(hll.empty());
+  ASSERT_EQ(hll.count(), 0U);
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    hll.insert(i);
+    hll.insert(i);
+  }
+  ASSERT_TRUE(hll.is_sparse());
+  ASSERT_NEAR(static_cast<double>(hll.count()), 100.0, 2.0);
+}
+
+TEST(HyperLogLogTest, SparseSmallerThanDense) {
+  for (uint8_t precision : {4, 10, 14, 18}) {
+    containers::hyperloglog<uint64_t> hll(precision);
+    size_t dense = hll.register_count();
+    for (uint64_t i = 0; hll.is_sparse(); ++i) {
+      hll.insert(i);
+      if (hll.is_sparse()) {
+        ASSERT_LT(hll.bytes(), dense / 2);
+      }
+    }
+    ASSERT_EQ(hll.bytes(), dense);
+  }
+}
+
+TEST(HyperLogLogTest, DenseEstimateWithinError) {
+  containers::hyperloglog<uint64_t> hll(12);
+  const double distinct = 200000;
+  for (uint64_t i = 0; i < distinct; ++i) {
+    hll.insert(i * 7919);
+  }
+  ASSERT_FALSE(hll.is_sparse());
+  ASSERT_NEAR(hll.estimate(), distinct, distinct * 0.05);
+}
+
+TEST(HyperLogLogTest, StringKeys) {
+  containers::hyperloglog<std::string> hll(10);
+  for (int i = 0; i < 5000; ++i) {
+    hll.insert("user-" + std::to_string(i % 1000));
+  }
+  ASSERT_NEAR(hll.estimate(), 1000.0, 1000.0 * 0.1);
+}
+
+TEST(HyperLogLogTest, MergeMatchesUnion) {
+  containers::hyperloglog<uint64_t> a(11), b(11), both(11);
+  for (uint64_t i = 0; i < 30000; ++i) {
+    (i % 2 ? a : b).insert(i);
+    both.insert(i);
+  }
+  containers::hyperloglog<uint64_t> small(11);
+  small.insert_many(uint64_t{1}, uint64_t{2}, uint64_t{3});
+
+  a.merge(b);
+  a.merge(small);
+  ASSERT_DOUBLE_EQ(a.estimate(), both.estimate());
+
+  small.merge(b);
+  ASSERT_FALSE(small.is_sparse());
+
+  containers::hyperloglog<uint64_t> other(12);
+  ASSERT_THROW(a.merge(other), std::runtime_error);
+}
+
+TEST(HyperLogLogTest, SerializeRoundTrip) {
+  containers::hyperloglog<uint64_t> sparse(14), dense(8);
+  for (uint64_t i = 0; i < 50; ++i) sparse.insert(i);
+  for (uint64_t i = 0; i < 5000; ++i) dense.insert(i);
+  ASSERT_TRUE(sparse.is_sparse());
+  ASSERT_FALSE(dense.is_sparse());
+
+  auto sparse_bytes = sparse.serialize();
+  auto dense_bytes = dense.serialize();
+  ASSERT_LT(sparse_bytes.size(), dense_bytes.size() * 4);
+
+  auto sparse_copy = containers::hyperloglog<uint64_t>::deserialize(
+      sparse_bytes);
+  auto dense_copy = containers::hyperloglog<uint64_t>::deserialize(
+      dense_bytes);
+  ASSERT_EQ(sparse_copy.precision(), 14);
+  ASSERT_TRUE(sparse_copy.is_sparse());
+  ASSERT_DOUBLE_EQ(sparse_copy.estimate(), sparse.estimate());
+  ASSERT_DOUBLE_EQ(dense_copy.estimate(), dense.estimate());
+
+  sparse_bytes.pop_back();
+  ASSERT_THROW(
+      containers::hyperloglog<uint64_t>::deserialize(sparse_bytes),
+      std::runtime_error);
+  dense_bytes[1] = 30;
+  ASSERT_THROW(containers::hyperloglog<uint64_t>::deserialize(dense_bytes),
+               std::runtime_error);
+}
+
+TEST(HyperLogLogTest, RegisterKernelsMatchScalar) {
+  std::mt19937 gen(85);
+  std::vector<uint8_t> a(1000), b(1000);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<uint8_t>(gen() % 12);
+    b[i] = static_cast<uint8_t>(gen() % 60);
+  }
+
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto r : a) {
+    sum += std::ldexp(1.0, -r);
+    zeros += !r;
+  }
+  auto total = containers::hll::sum_registers(a.data(), a.size());
+  ASSERT_NEAR(total.sum, sum, 1e-9);
+  ASSERT_EQ(total.zeros, zeros);
+
+  std::vector<uint8_t> merged(a);
+  containers::hll::merge_registers(merged.data(), b.data(), merged.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(merged[i], std::max(a[i], b[i]));
+  }
+}
+
+TEST(HyperLogLogTest, InvalidPrecision) {
+  ASSERT_THROW(containers::hyperloglog<int>(3), std::out_of_range);
+  ASSERT_THROW(containers::hyperloglog<int>(19), std::out_of_range);
+}
+TEST(DenseIntMapTest, NewTrivialValuesAreZero) {
+  containers::dense_int_map<uint32_t, uint8_t> map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(map[i * 31], 0);
+    map[i * 31] = 1;
+  }
+}
+TEST(CountMinSketchTest, NeverUnderestimates) {
+  auto sketch = containers::count_min_sketch<int>::from_error(0.001, 0.01);
+  ASSERT_GE(sketch.width(), 2719U);
+  ASSERT_EQ(sketch.depth(), 5U);
+
+  std::map<int, uint64_t> exact;
+  std::mt19937 gen(86);
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    sketch.update(key);
+    ++exact[key];
+  }
+  ASSERT_EQ(sketch.total(), 50000U);
+
+  uint64_t bound = static_cast<uint64_t>(0.001 * 50000) + 1;
+  size_t within = 0;
+  for (auto& it : exact) {
+    uint64_t estimate = sketch.estimate(it.first);
+    ASSERT_GE(estimate, it.second);
+    within += estimate - it.second <= bound;
+  }
+  ASSERT_GE(within, exact.size() * 99 / 100);
+}
+
+TEST(CountMinSketchTest, BatchUpdateMatchesSingle) {
+  containers::count_min_sketch<uint64_t> single(256, 4), batch(256, 4);
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < 1000; ++i) keys.push_back(i % 37);
+  for (auto key : keys) single.update(key);
+  batch.update(keys.begin(), keys.end());
+
+  for (uint64_t key = 0; key < 40; ++key) {
+    ASSERT_EQ(single.estimate(key), batch.estimate(key));
+  }
+}
+
+TEST(CountMinSketchTest, Merge) {
+  containers::count_min_sketch<std::string> a(64, 3), b(64, 3);
+  a.update("x", 5);
+  b.update("x", 7);
+  b.update("y");
+  a.merge(b);
+  ASSERT_GE(a.estimate("x"), 12U);
+  ASSERT_GE(a.estimate("y"), 1U);
+  ASSERT_EQ(a.total(), 13U);
+
+  containers::count_min_sketch<std::string> other(128, 3);
+  ASSERT_THROW(a.merge(other), std::runtime_error);
+  ASSERT_THROW(containers::count_min_sketch<int>(0, 3), std::out_of_range);
+}
+
+TEST(HeavyHittersTest, FindsHotKeys) {
+  containers::heavy_hitters<int> hh(5, 1024, 4);
+  std::mt19937 gen(87);
+  for (int i = 0; i < 100000; ++i) {
+    if (i % 4 == 0) {
+      hh.update(static_cast<int>(i / 4 % 5));
+    } else {
+      hh.update(100 + static_cast<int>(gen() % 20000));
+    }
+  }
+
+  ASSERT_EQ(hh.size(), 5U);
+  auto top = hh.top();
+  ASSERT_EQ(top.size(), 5U);
+  std::set<int> keys;
+  for (size_t i = 0; i < top.size(); ++i) {
+    keys.insert(top[i].first);
+    ASSERT_GE(top[i].second, 5000U);
+    if (i) {
+      ASSERT_GE(top[i - 1].second, top[i].second);
+    }
+  }
+  ASSERT_EQ(keys, (std::set<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(HeavyHittersTest, BatchAndMerge) {
+  containers::heavy_hitters<std::string> a(2, 512, 4), b(2, 512, 4);
+  std::vector<std::string> left{"a", "a", "a", "b", "c", "c"};
+  std::vector<std::string> right{"b", "b", "b", "b", "d", "d"};
+  a.update(left.begin(), left.end());
+  b.update(right.begin(), right.end());
+  ASSERT_TRUE(a.contains("a"));
+  ASSERT_TRUE(b.contains("b"));
+
+  a.merge(b);
+  auto top = a.top();
+  ASSERT_EQ(top.size(), 2U);
+  ASSERT_EQ(top[0].first, "b");
+  ASSERT_EQ(top[0].second, 5U);
+  ASSERT_EQ(top[1].first, "a");
+  ASSERT_FALSE(a.contains("d"));
+}
+
+TEST(HeavyHittersTest, BatchMatchesSingleUpdates) {
+  std::mt19937 gen(11);
+  std::vector<int> stream;
+  for (int i = 0; i < 20000; ++i) {
+    stream.push_back(i % 3 ? static_cast<int>(gen() % 5000)
+                           : static_cast<int>(gen() % 8));
+  }
+
+  containers::heavy_hitters<int> batched(8, 1024, 4), single(8, 1024, 4);
+  batched.update(stream.begin(), stream.end());
+  for (int key : stream) {
+    single.update(key);
+  }
+
+  ASSERT_EQ(batched.total(), single.total());
+  for (int key = 0; key < 8; ++key) {
+    ASSERT_TRUE(batched.contains(key));
+    ASSERT_EQ(batched.estimate(key), single.estimate(key));
+  }
+}
+
+TEST(HashTableTest, ReplaceKey) {
+  containers::hash_table<int, int> table;
+  for (int i = 0; i < 100; ++i) {
+    table.insert(i, i);
+  }
+  auto it = table.replace_key(table.find(42), 1042);
+  EXPECT_EQ(it->first, 1042);
+  EXPECT_EQ(it->second, 42);
+  EXPECT_FALSE(table.contains(42));
+  EXPECT_EQ(table.at(1042), 42);
+  EXPECT_EQ(table.size(), 100U);
+}
+
+TEST(CounterMapTest, AddAndGet) {
+  containers::counter_map<std::string> counters;
+  ASSERT_TRUE(counters.empty());
+  ASSERT_EQ(counters.add("hits"), 1);
+  ASSERT_EQ(counters.add("hits", 4), 5);
+  ASSERT_EQ(counters.increment("misses"), 1);
+  ASSERT_EQ(counters.get("hits"), 5);
+  ASSERT_EQ(counters.get("absent"), 0);
+  ASSERT_FALSE(counters.contains("absent"));
+  ASSERT_EQ(counters.size(), 2U);
+
+  counters.reset();
+  ASSERT_EQ(counters.get("hits"), 0);
+  ASSERT_EQ(counters.size(), 2U);
+}
+
+TEST(CounterMapTest, GrowsAcrossShards) {
+  containers::counter_map<int, containers::fast_hash<int>, 4> counters;
+  for (int i = 0; i < 10000; ++i) {
+    counters.add(i, i);
+  }
+  ASSERT_EQ(counters.size(), 10000U);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(counters.get(i), i);
+  }
+
+  auto entries = counters.scan();
+  ASSERT_EQ(entries.size(), 10000U);
+  int64_t sum = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    ASSERT_EQ(entries[i].first, entries[i].second);
+    sum += entries[i].second;
+  }
+  ASSERT_EQ(sum, int64_t{9999} * 10000 / 2);
+}
+
+TEST(CounterMapTest, ConcurrentIncrements) {
+  containers::counter_map<int> counters;
+  const int threads = 8, rounds = 20000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&counters, t] {
+      for (int i = 0; i < rounds; ++i) {
+        counters.increment(0);
+        counters.add(1 + (i * threads + t) % 5000, 2);
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  ASSERT_EQ(counters.get(0), threads * rounds);
+  int64_t total = 0;
+  auto entries = counters.scan();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    total += entries[i].second;
+  }
+  ASSERT_EQ(entries.size(), 5001U);
+  ASSERT_EQ(total, int64_t{3} * threads * rounds);
+}
+
+TEST(CounterMapTest, SnapshotIsPointInTime) {
+  // Each writer bumps keys 0..keys-1 in order, so at any instant the counts
+  // are non-increasing in key order and span at most one round per writer.
+  containers::counter_map<int> counters;
+  const int threads = 4, rounds = 5000, keys = 64;
+  for (int k = 0; k < keys; ++k) counters.add(k, 0);
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&counters] {
+      for (int i = 0; i < rounds; ++i) {
+        for (int k = 0; k < keys; ++k) counters.increment(k);
+      }
+    });
+  }
+  std::thread reader([&] {
+    while (!done.load()) {
+      auto entries = counters.snapshot();
+      ASSERT_EQ(entries.size(), size_t(keys));
+      std::vector<int64_t> counts(keys);
+      for (size_t i = 0; i < entries.size(); ++i) {
+        counts[entries[i].first] = entries[i].second;
+      }
+      for (int k = 1; k < keys; ++k) {
+        ASSERT_LE(counts[k], counts[k - 1]);
+      }
+      ASSERT_LE(counts[0] - counts[keys - 1], threads);
+    }
+  });
+  for (auto& worker : workers) worker.join();
+  done.store(true);
+  reader.join();
+
+  auto entries = counters.snapshot();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    ASSERT_EQ(entries[i].second, int64_t{threads} * rounds);
+  }
+}
+
+TEST(CounterMapTest, DeltaBufferFlushes) {
+  containers::counter_map<int> counters;
+  {
+    auto buffer = counters.buffer(3);
+    buffer.add(1);
+    buffer.add(1, 2);
+    buffer.add(2);
+    ASSERT_EQ(counters.get(1), 0);
+    ASSERT_EQ(buffer.size(), 2U);
+    buffer.add(3);
+    ASSERT_EQ(buffer.size(), 0U);
+    ASSERT_EQ(counters.get(1), 3);
+    buffer.add(4, 7);
+  }
+  ASSERT_EQ(counters.get(4), 7);
+  ASSERT_EQ(counters.size(), 4U);
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&counters] {
+      auto buffer = counters.buffer();
+      for (int i = 0; i < 10000; ++i) buffer.add(100);
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  ASSERT_EQ(counters.get(100), 40000);
+
+  auto hot = counters.buffer(4, 10);
+  for (int i = 0; i < 25; ++i) {
+    hot.add(5);
+  }
+  ASSERT_EQ(counters.get(5), 20);
+  ASSERT_EQ(hot.size(), 1U);
+  hot.flush();
+  ASSERT_EQ(counters.get(5), 25);
+  hot.add(5);
+  ASSERT_EQ(hot.size(), 1U);
+}
+TEST(LockfreeStackTest, PushPopOrder) {
+  containers::lockfree_stack<std::string, 4> stack;
+  ASSERT_TRUE(stack.empty());
+  for (int i = 0; i < 10; ++i) {
+    stack.push(std::to_string(i));
+  }
+  ASSERT_EQ(stack.capacity(), 12U);
+
+  std::string value;
+  for (int i = 9; i >= 0; --i) {
+    ASSERT_TRUE(stack.pop(value));
+    ASSERT_EQ(value, std::to_string(i));
+  }
+  ASSERT_FALSE(stack.pop(value));
+  ASSERT_TRUE(stack.empty());
+
+  for (int i = 0; i < 10; ++i) {
+    stack.emplace(3, 'x');
+  }
+  ASSERT_EQ(stack.capacity(), 12U);
+}
+
+TEST(LockfreeStackTest, PopAll) {
+  containers::lockfree_stack<int> stack(100);
+  ASSERT_EQ(stack.capacity(), containers::default_lockfree_chunk);
+  ASSERT_EQ(stack.pop_all().size(), 0U);
+
+  for (int i = 0; i < 5; ++i) stack.push(i);
+  auto all = stack.pop_all();
+  ASSERT_TRUE(stack.empty());
+  ASSERT_EQ(all.size(), 5U);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(all[i], 4 - i);
+  }
+}
+
+TEST(LockfreeStackTest, ConcurrentFreeList) {
+  containers::lockfree_stack<int, 64> stack;
+  const int threads = 8, rounds = 5000;
+  std::atomic<long long> popped_sum{0};
+  std::atomic<int> popped_count{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      int value;
+      for (int i = 0; i < rounds; ++i) {
+        stack.push(t * rounds + i);
+        if (i % 3 == 0 && stack.pop(value)) {
+          popped_sum += value;
+          ++popped_count;
+        }
+      }
+      auto rest = stack.pop_all();
+      for (size_t i = 0; i < rest.size(); ++i) {
+        popped_sum += rest[i];
+        ++popped_count;
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  int value;
+  while (stack.pop(value)) {
+    popped_sum += value;
+    ++popped_count;
+  }
+  long long total = static_cast<long long>(threads) * rounds;
+  ASSERT_EQ(popped_count.load(), total);
+  ASSERT_EQ(popped_sum.load(), total * (total - 1) / 2);
+}
+TEST(ChannelTest, TryOperations) {
+  containers::channel<int> ch(2);
+  ASSERT_EQ(ch.capacity(), 2U);
+  int value = 0;
+  ASSERT_FALSE(ch.try_pop(value));
+  ASSERT_TRUE(ch.try_push(1));
+  ASSERT_TRUE(ch.try_push(2));
+  ASSERT_FALSE(ch.try_push(3));
+  ASSERT_EQ(ch.size(), 2U);
+
+  ASSERT_TRUE(ch.try_pop(value));
+  ASSERT_EQ(value, 1);
+  ASSERT_THROW(containers::channel<int>(0), std::out_of_range);
+}
+
+TEST(ChannelTest, Timeouts) {
+  containers::channel<int> ch(1);
+  int value = 0;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_FALSE(ch.pop_for(value, std::chrono::milliseconds(20)));
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+
+  ASSERT_TRUE(ch.push_for(7, std::chrono::milliseconds(20)));
+  ASSERT_FALSE(ch.push_for(8, std::chrono::milliseconds(5)));
+  ASSERT_TRUE(ch.pop_for(value, std::chrono::milliseconds(5)));
+  ASSERT_EQ(value, 7);
+}
+
+TEST(ChannelTest, CloseWakesWaiters) {
+  containers::channel<std::string> ch(1);
+  std::atomic<int> finished{0};
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 3; ++i) {
+    waiters.emplace_back([&] {
+      std::string value;
+      if (!ch.pop(value)) ++finished;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ch.close();
+  for (auto& waiter : waiters) waiter.join();
+  ASSERT_EQ(finished.load(), 3);
+  ASSERT_TRUE(ch.closed());
+  ASSERT_FALSE(ch.push("late"));
+}
+
+TEST(ChannelTest, CloseDrainsRemaining) {
+  containers::channel<int> ch(4);
+  ch.push(1);
+  ch.push(2);
+  ch.close();
+  int value = 0;
+  ASSERT_TRUE(ch.pop(value));
+  ASSERT_EQ(value, 1);
+  ASSERT_TRUE(ch.pop(value));
+  ASSERT_FALSE(ch.pop(value));
+}
+
+TEST(ChannelTest, BatchedProducerConsumer) {
+  containers::channel<int> ch(16);
+  const int producers = 4, per_producer = 10000;
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&ch, p] {
+      std::vector<int> chunk;
+      for (int i = 0; i < per_producer; ++i) {
+        chunk.push_back(p * per_producer + i);
+        if (chunk.size() == 7 || i + 1 == per_producer) {
+          ASSERT_TRUE(ch.push_batch(chunk.begin(), chunk.end()) ==
+                      chunk.end());
+          chunk.clear();
+        }
+      }
+    });
+  }
+
+  std::vector<int> received;
+  std::thread consumer([&] {
+    int buffer[32];
+    while (size_t n = ch.pop_batch(buffer, 32)) {
+      ASSERT_LE(n, 32U);
+      received.insert(received.end(), buffer, buffer + n);
+    }
+  });
+  for (auto& thread : threads) thread.join();
+  ch.close();
+  consumer.join();
+
+  ASSERT_EQ(received.size(), static_cast<size_t>(producers * per_producer));
+  std::sort(received.begin(), received.end());
+  for (size_t i = 0; i < received.size(); ++i) {
+    ASSERT_EQ(received[i], static_cast<int>(i));
+  }
+}
+#if defined(__cpp_impl_coroutine)
+namespace {
+
+containers::detached_task consume(containers::async_queue<int>& queue,
+                                  std::vector<int>& out) {
+  while (auto value = co_await queue.pop()) {
+    out.push_back(*value);
+  }
+}
+
+containers::detached_task consume_on(containers::executor& ex,
+                                     containers::async_queue<int>& queue,
+                                     std::atomic<long long>& sum,
+                                     std::atomic<int>& done) {
+  co_await ex.schedule();
+  while (auto value = co_await queue.pop()) {
+    sum += *value;
+  }
+  ++done;
+}
+
+}
+
+TEST(AsyncQueueTest, SuspendsUntilPush) {
+  containers::manual_executor ex;
+  containers::async_queue<int> queue(ex);
+  std::vector<int> out;
+
+  int value = 0;
+  ASSERT_FALSE(queue.try_pop(value));
+  queue.push(7);
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(value, 7);
+
+  queue.push(1);
+  consume(queue, out);
+  ASSERT_EQ(out, (std::vector<int>{1}));
+
+  queue.push(2);
+  queue.push(3);
+  ASSERT_EQ(out.size(), 1U);
+  ASSERT_EQ(ex.run(), 1U);
+  ASSERT_EQ(out, (std::vector<int>{1, 2, 3}));
+
+  queue.close();
+  ASSERT_FALSE(queue.push(4));
+  ASSERT_EQ(ex.run(), 1U);
+  ASSERT_TRUE(queue.closed());
+}
+
+TEST(AsyncQueueTest, MoveOnlyValues) {
+  containers::manual_executor ex;
+  containers::async_queue<std::unique_ptr<int>> queue(ex);
+
+  std::unique_ptr<int> value;
+  queue.push(std::make_unique<int>(1));
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(*value, 1);
+
+  std::vector<int> out;
+  auto drain = [&]() -> containers::detached_task {
+    while (auto item = co_await queue.pop()) {
+      out.push_back(**item);
+    }
+  };
+  queue.push(std::make_unique<int>(2));
+  drain();
+  queue.push(std::make_unique<int>(3));
+  ex.run();
+  queue.close();
+  ex.run();
+  ASSERT_EQ(out, (std::vector<int>{2, 3}));
+}
+
+TEST(AsyncQueueTest, ManyWaitersWithoutThreads) {
+  containers::manual_executor ex;
+  containers::async_queue<int> queue(ex);
+  std::vector<std::vector<int>> outs(2000);
+  for (auto& out : outs) {
+    consume(queue, out);
+  }
+
+  for (int i = 0; i < 2000; ++i) {
+    queue.push(i);
+  }
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(ex.run(), 2000U);
+  for (size_t i = 0; i < outs.size(); ++i) {
+    ASSERT_EQ(outs[i], (std::vector<int>{static_cast<int>(i)}));
+  }
+
+  queue.push(5);
+  ASSERT_TRUE(queue.empty());
+  queue.close();
+  ASSERT_EQ(ex.run(), 2000U);
+  ASSERT_EQ(outs[0], (std::vector<int>{0, 5}));
+}
+
+TEST(AsyncQueueTest, ThreadPoolConsumers) {
+  std::atomic<long long> sum{0};
+  std::atomic<int> done{0};
+  {
+    containers::thread_pool_executor ex(4);
+    ASSERT_EQ(ex.size(), 4U);
+    containers::async_queue<int> queue(ex);
+    for (int i = 0; i < 100; ++i) {
+      consume_on(ex, queue, sum, done);
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+      producers.emplace_back([&queue, p] {
+        for (int i = 0; i < 5000; ++i) queue.push(p * 5000 + i);
+      });
+    }
+    for (auto& producer : producers) producer.join();
+
+    while (!queue.empty()) std::this_thread::yield();
+    queue.close();
+    while (done.load() != 100) std::this_thread::yield();
+  }
+  ASSERT_EQ(sum.load(), 9999LL * 10000 / 2);
+}
+#endif
+TEST(SlotMapTest, InsertFindErase) {
+  containers::slot_map<std::string> map;
+  auto a = map.insert("a");
+  auto b = map.emplace(2, 'b');
+  auto c = map.insert("c");
+  ASSERT_EQ(map.size(), 3U);
+  ASSERT_EQ(map[a], "a");
+  ASSERT_EQ(map.at(b), "bb");
+
+  ASSERT_TRUE(map.erase(a));
+  ASSERT_FALSE(map.erase(a));
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ(map.find(a), nullptr);
+  ASSERT_THROW(map.at(a), std::out_of_range);
+  ASSERT_EQ(map.at(c), "c");
+  ASSERT_EQ(map.size(), 2U);
+
+  auto d = map.insert("d");
+  ASSERT_EQ(d.index, a.index);
+  ASSERT_NE(d.generation, a.generation);
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ(map.at(d), "d");
+  ASSERT_EQ(map.slot_count(), 3U);
+}
+
+TEST(SlotMapTest, DenseIteration) {
+  containers::slot_map<int> map;
+  containers::Vector<containers::slot_handle> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(map.insert(i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_TRUE(map.erase(handles[i]));
+  }
+
+  ASSERT_EQ(static_cast<size_t>(map.end() - map.begin()), 50U);
+  int sum = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    ASSERT_EQ(*it % 2, 1);
+    ASSERT_EQ(map[map.handle_of(it)], *it);
+    sum += *it;
+  }
+  ASSERT_EQ(sum, 2500);
+  for (int i = 1; i < 100; i += 2) {
+    ASSERT_EQ(map.at(handles[i]), i);
+  }
+}
+
+TEST(SlotMapTest, ClearInvalidatesHandles) {
+  containers::slot_map<int> map;
+  auto a = map.insert(1);
+  auto b = map.insert(2);
+  containers::slot_map<int> copy;
+  copy = map;
+
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_FALSE(map.contains(b));
+  ASSERT_EQ(copy.at(b), 2);
+
+  auto c = map.insert(3);
+  ASSERT_LT(c.index, 2U);
+  ASSERT_EQ(map.slot_count(), 2U);
+}
+
+TEST(SlotMapTest, FreeSlotsNeverValidate) {
+  containers::slot_map<int> map;
+  auto a = map.insert(1);
+  map.erase(a);
+  containers::slot_handle forged{a.index, a.generation + 1};
+  ASSERT_FALSE(map.contains(forged));
+  ASSERT_EQ(map.find(forged), nullptr);
+  ASSERT_THROW(map.at(forged), std::out_of_range);
+  ASSERT_FALSE(map.erase(forged));
+
+  auto b = map.insert(2);
+  ASSERT_EQ(b.index, a.index);
+  ASSERT_EQ(map.at(b), 2);
+  ASSERT_FALSE(map.contains(a));
+  map.clear();
+  ASSERT_FALSE(map.contains({b.index, b.generation + 1}));
+}
+TEST(SparseSetTest, InsertEraseContains) {
+  containers::sparse_set<uint32_t> set{5, 1, 9};
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_FALSE(set.insert(5));
+  ASSERT_TRUE(set.contains(9));
+  ASSERT_FALSE(set.contains(2));
+  ASSERT_FALSE(set.contains(100000));
+  ASSERT_EQ(set.index_of(1), 1U);
+
+  ASSERT_TRUE(set.erase(5));
+  ASSERT_FALSE(set.erase(5));
+  ASSERT_FALSE(set.contains(5));
+  ASSERT_EQ(std::vector<uint32_t>(set.begin(), set.end()),
+            (std::vector<uint32_t>{9, 1}));
+  ASSERT_THROW(set.index_of(5), std::out_of_range);
+}
+
+TEST(SparseSetTest, ClearIsConstantAndReusable) {
+  containers::sparse_set<uint16_t> set(1000);
+  ASSERT_EQ(set.universe(), 1000U);
+  for (uint16_t i = 0; i < 1000; i += 3) set.insert(i);
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.universe(), 1000U);
+  for (uint16_t i = 0; i < 1000; ++i) {
+    ASSERT_FALSE(set.contains(i));
+  }
+
+  set.insert(999);
+  set.insert(3);
+  ASSERT_TRUE(set.contains(3));
+  ASSERT_FALSE(set.contains(6));
+  ASSERT_EQ(set.size(), 2U);
+}
+
+TEST(SparseSetTest, MatchesStdSet) {
+  containers::sparse_set<uint32_t> set;
+  std::set<uint32_t> expected;
+  std::mt19937 gen(92);
+  for (int i = 0; i < 20000; ++i) {
+    uint32_t id = gen() % 4096;
+    if (gen() % 3 == 0) {
+      ASSERT_EQ(set.erase(id), expected.erase(id) == 1);
+    } else {
+      ASSERT_EQ(set.insert(id), expected.insert(id).second);
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(std::set<uint32_t>(set.begin(), set.end()), expected);
+
+  containers::sparse_set<uint32_t> copy(set);
+  set.clear();
+  ASSERT_EQ(copy.size(), expected.size());
+}
+TEST(FenwickTreeTest, PrefixAndRangeSums) {
+  containers::Vector<int64_t> values{3, 1, 4, 1, 5, 9, 2, 6};
+  containers::fenwick_tree<int64_t> tree(values);
+  ASSERT_EQ(tree.size(), 8U);
+  ASSERT_EQ(tree.prefix_sum(0), 0);
+  ASSERT_EQ(tree.prefix_sum(8), 31);
+  ASSERT_EQ(tree.range_sum(2, 5), 10);
+  ASSERT_EQ(tree.get(5), 9);
+
+  tree.add(0, 10);
+  tree.set(7, 0);
+  ASSERT_EQ(tree.prefix_sum(8), 35);
+  ASSERT_EQ(tree.get(0), 13);
+  ASSERT_THROW(tree.add(8, 1), std::out_of_range);
+  ASSERT_THROW(tree.range_sum(5, 2), std::out_of_range);
+}
+
+TEST(FenwickTreeTest, LowerBoundMatchesPrefixSums) {
+  std::mt19937 gen(93);
+  containers::Vector<int> values;
+  for (int i = 0; i < 300; ++i) values.push_back(static_cast<int>(gen() % 5));
+  containers::fenwick_tree<int> tree(values);
+
+  for (int target = 0; target <= tree.prefix_sum(300) + 1; ++target) {
+    size_t expected = 0;
+    int sum = 0;
+    while (expected < 300 && sum + values[expected] < target) {
+      sum += values[expected++];
+    }
+    if (target <= 0) expected = 0;
+    ASSERT_EQ(tree.lower_bound(target), expected) << target;
+  }
+}
+
+TEST(SegmentTreeTest, PointUpdatesAndQueries) {
+  containers::Vector<int> values{5, 2, 8, 1, 9, 3, 7};
+  containers::segment_tree<int, containers::min_op<int>> mins(values);
+  containers::segment_tree<int, containers::max_op<int>> maxs(values);
+  containers::segment_tree<int> sums(values);
+
+  ASSERT_EQ(mins.query(0, 7), 1);
+  ASSERT_EQ(mins.query(4, 7), 3);
+  ASSERT_EQ(maxs.query(0, 4), 8);
+  ASSERT_EQ(sums.query(1, 3), 10);
+  ASSERT_EQ(sums.all(), 35);
+  ASSERT_EQ(mins.query(2, 2), std::numeric_limits<int>::max());
+
+  mins.set(3, 10);
+  ASSERT_EQ(mins.query(0, 7), 2);
+  ASSERT_EQ(mins.get(3), 10);
+  ASSERT_THROW(mins.query(3, 8), std::out_of_range);
+  ASSERT_FALSE(mins.lazy());
+}
+
+TEST(SegmentTreeTest, LazyRangeAddMatchesBruteForce) {
+  std::mt19937 gen(930);
+  const size_t n = 37;
+  std::vector<long long> brute(n);
+  containers::Vector<long long> values;
+  for (size_t i = 0; i < n; ++i) {
+    brute[i] = static_cast<long long>(gen() % 100);
+    values.push_back(brute[i]);
+  }
+  containers::segment_tree<long long> sums(values);
+  containers::segment_tree<long long, containers::min_op<long long>> mins(
+      values);
+
+  for (int step = 0; step < 3000; ++step) {
+    size_t a = gen() % (n + 1), b = gen() % (n + 1);
+    size_t first = std::min(a, b), last = std::max(a, b);
+    int kind = static_cast<int>(gen() % 3);
+    if (kind == 0) {
+      long long delta = static_cast<long long>(gen() % 21) - 10;
+      sums.range_add(first, last, delta);
+      mins.range_add(first, last, delta);
+      for (size_t i = first; i < last; ++i) brute[i] += delta;
+    } else if (kind == 1 && first < n) {
+      long long value = static_cast<long long>(gen() % 100);
+      sums.set(first, value);
+      mins.set(first, value);
+      brute[first] = value;
+    } else {
+      long long sum = 0, low = std::numeric_limits<long long>::max();
+      for (size_t i = first; i < last; ++i) {
+        sum += brute[i];
+        low = std::min(low, brute[i]);
+      }
+      ASSERT_EQ(sums.query(first, last), sum);
+      ASSERT_EQ(mins.query(first, last), low);
+    }
+  }
+  ASSERT_TRUE(sums.lazy());
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(sums.get(i), brute[i]);
+  }
+
+  containers::segment_tree<long long> copy(sums);
+  ASSERT_EQ(copy.query(0, n), sums.query(0, n));
+}
+
+TEST(RadixTreeTest, StringKeysWithSharedPrefixes) {
+  containers::radix_tree<std::string, int> tree{
+      {"romane", 1}, {"romanus", 2}, {"romulus", 3}, {"rubens", 4},
+      {"ruber", 5},  {"rubicon", 6}, {"rubicundus", 7}};
+  tree.insert("rom", 8);
+  tree["r"] = 9;
+  tree.insert("", 10);
+
+  ASSERT_EQ(tree.size(), 10U);
+  ASSERT_FALSE(tree.insert("ruber", 50).second);
+  ASSERT_EQ(tree.at("ruber"), 5);
+  ASSERT_EQ(tree.at("rom"), 8);
+  ASSERT_EQ(tree.at(""), 10);
+  ASSERT_FALSE(tree.contains("roma"));
+  ASSERT_FALSE(tree.contains("rubiconx"));
+  ASSERT_THROW(tree.at("rub"), std::out_of_range);
+
+  std::vector<std::string> keys;
+  for (auto& it : tree) keys.push_back(it.first);
+  std::vector<std::string> expected{"",        "r",      "rom",
+                                    "romane",  "romanus", "romulus",
+                                    "rubens",  "ruber",  "rubicon",
+                                    "rubicundus"};
+  ASSERT_EQ(keys, expected);
+
+  ASSERT_EQ(tree.erase("rom"), 1U);
+  ASSERT_EQ(tree.erase("rom"), 0U);
+  ASSERT_EQ(tree.erase("roman"), 0U);
+  tree.erase(tree.find("rubicon"));
+  ASSERT_EQ(tree.size(), 8U);
+  ASSERT_TRUE(tree.contains("rubicundus"));
+  ASSERT_EQ(tree.find("rubicon"), tree.end());
+
+  auto it = tree.find("romulus");
+  ASSERT_EQ((++it)->first, "rubens");
+}
+
+TEST(RadixTreeTest, PrefixScan) {
+  containers::radix_tree<std::string, int> tree;
+  std::vector<std::string> words{"car",  "card", "care",  "cared", "cart",
+                                 "cat",  "dog",  "do",    "carbon", "c"};
+  for (size_t i = 0; i < words.size(); ++i) {
+    tree.insert(words[i], static_cast<int>(i));
+  }
+
+  auto collect = [&tree](const std::string& prefix) {
+    std::vector<std::string> out;
+    auto range = tree.prefix_scan(prefix);
+    for (auto it = range.first; it != range.second; ++it) {
+      out.push_back(it->first);
+    }
+    return out;
+  };
+  ASSERT_EQ(collect("car"), (std::vector<std::string>{
+                                "car", "carbon", "card", "care", "cared",
+                                "cart"}));
+  ASSERT_EQ(collect("care"), (std::vector<std::string>{"care", "cared"}));
+  ASSERT_EQ(collect("ca"), (std::vector<std::string>{
+                               "car", "carbon", "card", "care", "cared",
+                               "cart", "cat"}));
+  ASSERT_EQ(collect("d"), (std::vector<std::string>{"do", "dog"}));
+  ASSERT_EQ(collect("cab").size(), 0U);
+  ASSERT_EQ(collect("carbonate").size(), 0U);
+  ASSERT_EQ(collect("").size(), words.size());
+}
+
+TEST(RadixTreeTest, RandomizedAgainstStdMap) {
+  std::mt19937 gen(940);
+  containers::radix_tree<std::string, int> tree;
+  std::map<std::string, int> reference;
+  const std::string alphabet = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+  for (int step = 0; step < 20000; ++step) {
+    std::string key;
+    size_t length = gen() % 6;
+    size_t letters = step < 10000 ? 4 : alphabet.size();
+    for (size_t i = 0; i < length; ++i) key += alphabet[gen() % letters];
+
+    if (gen() % 3) {
+      int value = static_cast<int>(gen());
+      tree.insert_or_assign(key, value);
+      reference[key] = value;
+    } else {
+      ASSERT_EQ(tree.erase(key), reference.erase(key));
+    }
+    ASSERT_EQ(tree.size(), reference.size());
+  }
+
+  auto expected = reference.begin();
+  for (auto& it : tree) {
+    ASSERT_EQ(it.first, expected->first);
+    ASSERT_EQ(it.second, expected->second);
+    ++expected;
+  }
+  ASSERT_EQ(expected, reference.end());
+
+  containers::radix_tree<std::string, int> copy(tree);
+  for (auto& it : reference) {
+    ASSERT_EQ(tree.erase(it.first), 1U);
+  }
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.begin(), tree.end());
+  ASSERT_EQ(copy.size(), reference.size());
+  ASSERT_EQ(copy.at(reference.begin()->first), reference.begin()->second);
+}
+
+TEST(RadixTreeTest, IntegerKeysKeepNumericOrder) {
+  containers::radix_tree<int, int> tree;
+  std::set<int> reference;
+  std::mt19937 gen(941);
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 2001) - 1000;
+    tree[key] = key * 2;
+    reference.insert(key);
+  }
+  tree.insert(std::numeric_limits<int>::min(), 0);
+  tree.insert(std::numeric_limits<int>::max(), 0);
+  reference.insert(std::numeric_limits<int>::min());
+  reference.insert(std::numeric_limits<int>::max());
+
+  ASSERT_EQ(tree.size(), reference.size());
+  auto expected = reference.begin();
+  for (auto& it : tree) {
+    ASSERT_EQ(it.first, *expected++);
+  }
+  for (int key = -1000; key <= 1000; key += 2) {
+    tree.erase(key);
+    reference.erase(key);
+  }
+  ASSERT_EQ(tree.size(), reference.size());
+  for (int key : reference) {
+    if (key > -1000 && key < 1000) {
+      ASSERT_EQ(tree.at(key), key * 2);
+    }
+  }
+  ASSERT_FALSE(tree.contains(0));
+}
+
+TEST(StringPoolTest, InternDeduplicatesStrings) {
+  containers::string_pool pool(64);
+  auto apple = pool.intern("apple");
+  auto pear = pool.intern(std::string("pear"));
+  auto empty = pool.intern("");
+  ASSERT_EQ(pool.intern(std::string_view("apple")), apple);
+  ASSERT_NE(apple, pear);
+  ASSERT_EQ(pool.size(), 3U);
+  ASSERT_EQ(pool.bytes(), 9U);
+
+  ASSERT_EQ(pool[apple], "apple");
+  ASSERT_EQ(pool.at(pear), "pear");
+  ASSERT_EQ(pool.at(empty), "");
+  ASSERT_THROW(pool.at(3), std::out_of_range);
+  ASSERT_EQ(pool.find("pear"), pear);
+  ASSERT_EQ(pool.find("plum"), containers::string_pool::npos);
+  ASSERT_TRUE(pool.contains("apple"));
+  ASSERT_FALSE(pool.contains("appl"));
+
+  std::string_view stored = pool.store("apple");
+  ASSERT_EQ(stored.data(), pool[apple].data());
+
+  pool.clear();
+  ASSERT_TRUE(pool.empty());
+  ASSERT_EQ(pool.intern("pear"), 0U);
+}
+
+TEST(StringPoolTest, ViewsStayValidAcrossGrowth) {
+  containers::string_pool pool(32);
+  std::vector<std::string_view> views;
+  std::vector<std::string> expected;
+  for (int i = 0; i < 2000; ++i) {
+    std::string value = "key-" + std::to_string(i % 700);
+    if (i % 250 == 0) value += std::string(100, 'x');
+    views.push_back(pool.store(value));
+    expected.push_back(value);
+  }
+  ASSERT_EQ(pool.size(), 708U);
+  for (size_t i = 0; i < views.size(); ++i) {
+    ASSERT_EQ(views[i], expected[i]);
+    ASSERT_EQ(pool.store(expected[i]).data(), views[i].data());
+  }
+
+  containers::string_pool moved(std::move(pool));
+  ASSERT_EQ(moved.size(), 708U);
+  ASSERT_EQ(moved[moved.find("key-5")], "key-5");
+  ASSERT_EQ(views[5], "key-5");
+}
+
+TEST(SmallStringTest, InlineAndHeapStorage) {
+  static_assert(sizeof(containers::small_string) == 24);
+  containers::small_string empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_STREQ(empty.c_str(), "");
+
+  containers::small_string s("hello");
+  ASSERT_TRUE(s.is_inline());
+  ASSERT_EQ(s.size(), 5U);
+  ASSERT_EQ(s, "hello");
+  s.append(", world of strings");
+  ASSERT_EQ(s.size(), 23U);
+  ASSERT_TRUE(s.is_inline());
+  ASSERT_STREQ(s.c_str(), "hello, world of strings");
+
+  s.push_back('!');
+  ASSERT_FALSE(s.is_inline());
+  ASSERT_EQ(s.view(), "hello, world of strings!");
+  ASSERT_GE(s.capacity(), 24U);
+  s += s;
+  ASSERT_EQ(s.str(), "hello, world of strings!hello, world of strings!");
+  s.pop_back();
+  ASSERT_EQ(s.back(), 's');
+  ASSERT_EQ(s.at(0), 'h');
+  ASSERT_THROW(s.at(s.size()), std::out_of_range);
+
+  s.resize(3);
+  ASSERT_EQ(s, "hel");
+  s.clear();
+  ASSERT_TRUE(s.empty());
+  ASSERT_STREQ(s.c_str(), "");
+
+  containers::small_string filled(30, 'z');
+  containers::small_string moved(std::move(filled));
+  ASSERT_TRUE(filled.empty());
+  ASSERT_EQ(moved, std::string(30, 'z'));
+  moved = containers::small_string("tiny");
+  ASSERT_EQ(moved, "tiny");
+}
+
+TEST(SmallStringTest, ComparisonAndHashing) {
+  containers::small_string a("abc"), b(std::string("abc")), c("abd");
+  containers::small_string long_a(std::string(40, 'q'));
+  containers::small_string long_b(std::string(40, 'q'));
+  ASSERT_EQ(a, b);
+  ASSERT_NE(a, c);
+  ASSERT_LT(a, c);
+  ASSERT_EQ(long_a, long_b);
+  ASSERT_NE(a, long_a);
+  ASSERT_TRUE(a == std::string_view("abc"));
+  ASSERT_TRUE(std::string_view("abd") == c);
+
+  a.append("x");
+  a.pop_back();
+  ASSERT_EQ(a, b);
+  a = "abcdef";
+  a.resize(3);
+  ASSERT_EQ(a, b);
+
+  containers::fast_hash<containers::small_string> hash;
+  containers::fast_hash<std::string_view> view_hash;
+  ASSERT_EQ(hash(a), view_hash("abc"));
+  ASSERT_EQ(hash(long_a), hash(long_b));
+
+  containers::hash_table<containers::small_string, int> table;
+  std::map<std::string, int> reference;
+  for (int i = 0; i < 500; ++i) {
+    std::string key = "k" + std::to_string(i * 7919 % 1000);
+    if (i % 50 == 0) key += std::string(30, '#');
+    table[containers::small_string(key)] += i;
+    reference[key] += i;
+  }
+  ASSERT_EQ(table.size(), reference.size());
+  for (auto& it : reference) {
+    ASSERT_EQ(table.at(containers::small_string(it.first)), it.second);
+  }
+}
+
+TEST(RopeTest, EditsMatchStdString) {
+  std::mt19937 gen(970);
+  std::string reference(20000, ' ');
+  for (auto& ch : reference) ch = static_cast<char>('a' + gen() % 26);
+  containers::rope text(reference);
+  ASSERT_EQ(text.size(), reference.size());
+  ASSERT_GE(text.chunk_count(), 5U);
+
+  for (int step = 0; step < 2000; ++step) {
+    size_t pos = gen() % (reference.size() + 1);
+    if (gen() % 2) {
+      std::string piece(gen() % 300, static_cast<char>('A' + step % 26));
+      if (step % 100 == 0) piece.assign(9000, '#');
+      text.insert(pos, piece);
+      reference.insert(pos, piece);
+    } else {
+      size_t count = gen() % 400;
+      text.erase(pos, count);
+      reference.erase(pos, count);
+    }
+    ASSERT_EQ(text.size(), reference.size());
+    if (!reference.empty()) {
+      size_t probe = gen() % reference.size();
+      ASSERT_EQ(text.at(probe), reference[probe]);
+    }
+  }
+  ASSERT_EQ(text.str(), reference);
+  ASSERT_LE(text.height(), 40);
+
+  size_t total = 0;
+  for (auto chunk : text.chunks()) {
+    ASSERT_FALSE(chunk.empty());
+    ASSERT_LE(chunk.size(), containers::rope_chunk_size);
+    total += chunk.size();
+  }
+  ASSERT_EQ(total, reference.size());
+  ASSERT_EQ(text.substr(100, 5000).str(), reference.substr(100, 5000));
+  ASSERT_THROW(text.at(reference.size()), std::out_of_range);
+  ASSERT_THROW(text.insert(reference.size() + 1, "x"), std::out_of_range);
+}
+
+TEST(RopeTest, ConcatenationSharesChunks) {
+  containers::rope hello("hello ");
+  containers::rope world("world");
+  containers::rope both = hello + world;
+  ASSERT_EQ(both.str(), "hello world");
+
+  containers::rope copy(both);
+  copy.insert(5, ",");
+  copy.erase(0, 1);
+  ASSERT_EQ(copy.str(), "ello, world");
+  ASSERT_EQ(both.str(), "hello world");
+
+  containers::rope doubled;
+  doubled.append(std::string(3000, 'x'));
+  for (int i = 0; i < 12; ++i) doubled += doubled;
+  ASSERT_EQ(doubled.size(), 3000U << 12);
+  ASSERT_EQ(doubled.chunk_count(), 1U << 12);
+  ASSERT_LE(doubled.height(), 14);
+  size_t middle = doubled.size() / 2;
+  doubled.insert(middle, both);
+  ASSERT_EQ(doubled.substr(middle - 3, 17).str(),
+            "xxxhello worldxxx");
+
+  doubled.erase(3, doubled.size() - 6);
+  ASSERT_EQ(doubled.str(), "xxxxxx");
+  ASSERT_EQ(doubled.chunk_count(), 1U);
+  doubled.clear();
+  ASSERT_TRUE(doubled.empty());
+}
+
+TEST(NdarrayTest, RowMajorStridesAndIndexing) {
+  containers::ndarray<int, 3> cube({2, 3, 4}, -1);
+  ASSERT_EQ(cube.size(), 24U);
+  ASSERT_EQ(cube.stride(0), 12U);
+  ASSERT_EQ(cube.stride(1), 4U);
+  ASSERT_EQ(cube.stride(2), 1U);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(cube.data()) %
+                containers::cache_line_size,
+            0U);
+
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      for (size_t k = 0; k < 4; ++k) {
+        cube(i, j, k) = static_cast<int>(i * 100 + j * 10 + k);
+      }
+    }
+  }
+  ASSERT_EQ(cube.data()[1 * 12 + 2 * 4 + 3], 123);
+  ASSERT_EQ(cube.at(1, 2, 3), 123);
+  ASSERT_THROW(cube.at(2, 0, 0), std::out_of_range);
+  ASSERT_THROW(cube.at(0, 0, 4), std::out_of_range);
+
+  containers::ndarray<int, 3> copy;
+  copy = cube;
+  cube.fill(0);
+  ASSERT_EQ(copy(0, 1, 2), 12);
+  ASSERT_EQ(cube(0, 1, 2), 0);
+}
+
+TEST(MatrixTest, ViewsAndLayouts) {
+  containers::matrix<int> m(3, 5);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) m(i, j) = static_cast<int>(i * 5 + j);
+  }
+  ASSERT_EQ(m.data()[7], 7);
+  ASSERT_EQ(m.row(1)[4], 9);
+  ASSERT_EQ(m.col(3).size(), 3U);
+  ASSERT_EQ(m.col(3)[2], 13);
+  m.col(0)[1] = -5;
+  ASSERT_EQ(m(1, 0), -5);
+  ASSERT_THROW(m.at(3, 0), std::out_of_range);
+  ASSERT_THROW(m.row(0).at(5), std::out_of_range);
+
+  containers::matrix<int, containers::tiled<4>> tiles(m);
+  ASSERT_EQ(tiles(1, 0), -5);
+  ASSERT_EQ(tiles(2, 4), 14);
+  ASSERT_EQ(tiles.data()[4 * 4 * 1 + 0], 4);
+
+  auto t = tiles.transpose();
+  ASSERT_EQ(t.rows(), 5U);
+  ASSERT_EQ(t(4, 2), 14);
+  ASSERT_EQ(containers::matrix<int>(t), m.transpose());
+  ASSERT_EQ(containers::matrix<int>(t.transpose()), m);
+}
+
+TEST(MatrixTest, BlockedMultiplyMatchesNaive) {
+  std::mt19937 gen(980);
+  const size_t n = 45, k = 70, p = 33;
+  containers::matrix<long long> a(n, k), b(k, p);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < k; ++j) a(i, j) = gen() % 19 - 9;
+  }
+  for (size_t i = 0; i < k; ++i) {
+    for (size_t j = 0; j < p; ++j) b(i, j) = gen() % 19 - 9;
+  }
+
+  containers::matrix<long long> expected(n, p);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < p; ++j) {
+      for (size_t x = 0; x < k; ++x) expected(i, j) += a(i, x) * b(x, j);
+    }
+  }
+  ASSERT_EQ(a * b, expected);
+
+  using tiled = containers::matrix<long long, containers::tiled<16>>;
+  tiled product = tiled(a) * tiled(b);
+  ASSERT_EQ(containers::matrix<long long>(product), expected);
+  ASSERT_THROW(a * a, std::runtime_error);
+}
+
+TEST(CsrGraphTest, BuildAndBreadthFirstSearch) {
+  std::mt19937 gen(990);
+  const size_t vertices = 500;
+  containers::Vector<std::pair<uint32_t, uint32_t>> edges;
+  std::vector<std::vector<uint32_t>> adjacency(vertices);
+  for (int i = 0; i < 3000; ++i) {
+    uint32_t from = gen() % vertices, to = gen() % vertices;
+    edges.push_back({from, to});
+    adjacency[from].push_back(to);
+  }
+
+  containers::parallel_policy sequential;
+  containers::parallel_policy threaded;
+  threaded.threads = 4;
+  threaded.threshold = 0;
+  containers::csr_graph<> graph(vertices, edges, sequential);
+  containers::csr_graph<> parallel_graph(vertices, edges, threaded);
+  ASSERT_EQ(graph.vertex_count(), vertices);
+  ASSERT_EQ(graph.edge_count(), edges.size());
+
+  for (uint32_t v = 0; v < vertices; ++v) {
+    auto row = graph.neighbors(v);
+    auto parallel_row = parallel_graph.neighbors(v);
+    ASSERT_EQ(graph.degree(v), adjacency[v].size());
+    ASSERT_EQ(std::vector<uint32_t>(row.begin(), row.end()), adjacency[v]);
+    ASSERT_EQ(std::vector<uint32_t>(parallel_row.begin(), parallel_row.end()),
+              adjacency[v]);
+  }
+
+  std::vector<uint32_t> expected(vertices,
+                                 containers::csr_graph<>::unreachable);
+  std::queue<uint32_t> pending;
+  expected[7] = 0;
+  pending.push(7);
+  while (!pending.empty()) {
+    uint32_t v = pending.front();
+    pending.pop();
+    for (uint32_t u : adjacency[v]) {
+      if (expected[u] == containers::csr_graph<>::unreachable) {
+        expected[u] = expected[v] + 1;
+        pending.push(u);
+      }
+    }
+  }
+  auto levels = graph.bfs(7);
+  ASSERT_EQ(std::vector<uint32_t>(levels.begin(), levels.end()), expected);
+
+  ASSERT_THROW(graph.bfs(vertices), std::out_of_range);
+  edges.push_back({1, static_cast<uint32_t>(vertices)});
+  ASSERT_THROW(containers::csr_graph<>(vertices, edges, threaded),
+               std::out_of_range);
+}
+
+TEST(CsrMatrixTest, SparseMatrixVectorProduct) {
+  std::mt19937 gen(991);
+  const size_t rows = 300, cols = 200;
+  using matrix = containers::csr_matrix<double>;
+  containers::Vector<matrix::entry> entries;
+  std::vector<std::vector<double>> dense(rows, std::vector<double>(cols));
+  for (int i = 0; i < 4000; ++i) {
+    size_t r = gen() % rows;
+    uint32_t c = gen() % cols;
+    double value = static_cast<double>(gen() % 9) - 4;
+    entries.push_back({r, c, value});
+    dense[r][c] += value;
+  }
+
+  containers::parallel_policy threaded;
+  threaded.threads = 3;
+  threaded.threshold = 0;
+  matrix m(rows, cols, entries);
+  matrix parallel_m(rows, cols, entries, threaded);
+  ASSERT_EQ(m.nonzeros(), entries.size());
+  ASSERT_EQ(m.row_indices(5).size(), m.row_values(5).size());
+
+  containers::Vector<double> x(cols);
+  for (size_t i = 0; i < cols; ++i) x.data()[i] = static_cast<double>(i % 7);
+  auto y = m.multiply(x);
+  auto parallel_y = parallel_m.multiply(x, threaded);
+  for (size_t r = 0; r < rows; ++r) {
+    double expected = 0;
+    for (size_t c = 0; c < cols; ++c) expected += dense[r][c] * (c % 7);
+    ASSERT_DOUBLE_EQ(y.data()[r], expected);
+    ASSERT_DOUBLE_EQ(parallel_y.data()[r], expected);
+  }
+  ASSERT_THROW(m.multiply(containers::Vector<double>(3)), std::runtime_error);
+}
+
+TEST(HdrHistogramTest, PercentilesStayWithinBucketPrecision) {
+  containers::hdr_histogram histogram;
+  ASSERT_EQ(histogram.percentile(99.0), 0U);
+  for (uint64_t value = 1; value <= 100000; ++value) {
+    histogram.record(value);
+  }
+  ASSERT_EQ(histogram.count(), 100000U);
+  ASSERT_EQ(histogram.max(), 100000U);
+
+  auto near = [](uint64_t reported, double expected) {
+    return reported >= expected && reported <= expected * (1 + 1.0 / 64) + 1;
+  };
+  ASSERT_TRUE(near(histogram.percentile(50.0), 50000));
+  ASSERT_TRUE(near(histogram.percentile(99.0), 99000));
+  ASSERT_TRUE(near(histogram.percentile(99.9), 99900));
+  ASSERT_EQ(histogram.percentile(100.0), 100000U);
+  ASSERT_EQ(histogram.percentile(0.0), 1U);
+
+  histogram.record(uint64_t{1} << 50);
+  ASSERT_EQ(histogram.max(), uint64_t{1} << 50);
+  ASSERT_EQ(histogram.percentile(100.0), uint64_t{1} << 50);
+  histogram.reset();
+  ASSERT_EQ(histogram.count(), 0U);
+}
+
+TEST(HdrHistogramTest, ConcurrentRecordingKeepsEveryValue) {
+  containers::hdr_histogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram, t] {
+      for (uint64_t i = 0; i < 20000; ++i) histogram.record(i * (t + 1));
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_EQ(histogram.count(), 80000U);
+  ASSERT_EQ(histogram.max(), 19999U * 4);
+}
+
+TEST(LatencyStatsTest, RegistryReportsPerInstanceStats) {
+  namespace inst = containers::instrumentation;
+  {
+    inst::operation_stats stats("request_cache");
+    for (int i = 0; i < 100; ++i) {
+      inst::scoped_timer timer(stats[inst::operation::find]);
+    }
+    stats[inst::operation::rehash].record(5000);
+
+    bool found = false;
+    for (auto& line : inst::registry::instance().summaries()) {
+      if (line.container != "request_cache") continue;
+      if (line.op == inst::operation::find) {
+        ASSERT_EQ(line.count, 100U);
+        ASSERT_LE(line.p50, line.p99);
+        ASSERT_LE(line.p999, line.max);
+        found = true;
+      } else {
+        ASSERT_EQ(line.op, inst::operation::rehash);
+        ASSERT_EQ(line.max, 5000U);
+      }
+    }
+    ASSERT_TRUE(found);
+
+    std::ostringstream out;
+    inst::registry::instance().dump(out);
+    ASSERT_NE(out.str().find("request_cache rehash count=1"),
+              std::string::npos);
+  }
+  for (auto& line : inst::registry::instance().summaries()) {
+    ASSERT_NE(line.container, "request_cache");
+  }
+}
+
+#if defined(CONTAINERS_INSTRUMENT)
+TEST(LatencyStatsTest, ContainersRecordTheirOperations) {
+  namespace inst = containers::instrumentation;
+  auto& vector_stats = inst::stats_for<containers::Vector<short>>();
+  auto& table_stats = inst::stats_for<containers::hash_table<short, short>>();
+  vector_stats.reset();
+  table_stats.reset();
+
+  containers::Vector<short> values;
+  containers::hash_table<short, short> table;
+  for (short i = 0; i < 100; ++i) {
+    values.push_back(i);
+    table.insert(i, i);
+  }
+  values.pop_back();
+  table.find(3);
+
+  ASSERT_EQ(vector_stats[inst::operation::push].count(), 100U);
+  ASSERT_EQ(vector_stats[inst::operation::pop].count(), 1U);
+  ASSERT_GT(vector_stats[inst::operation::growth].count(), 0U);
+  ASSERT_EQ(table_stats[inst::operation::insert].count(), 100U);
+  ASSERT_EQ(table_stats[inst::operation::find].count(), 1U);
+  ASSERT_GT(table_stats[inst::operation::rehash].count(), 0U);
+
+  table_stats.reset();
+  for (short i = 0; i < 10; ++i) {
+    table[i] = i;
+  }
+  ASSERT_EQ(table_stats[inst::operation::insert].count(), 10U);
+  ASSERT_EQ(table.at(5), 5);
+  ASSERT_EQ(table_stats[inst::operation::insert].count(), 10U);
+  ASSERT_EQ(table_stats[inst::operation::find].count(), 1U);
+}
+
+TEST(LatencyStatsTest, SmallTableRecordsInlineOperations) {
+  namespace inst = containers::instrumentation;
+  using small = containers::small_table<int, int>;
+  auto& small_stats = inst::stats_for<small>();
+  small_stats.reset();
+
+  small table;
+  table.insert(1, 1);
+  table[2] = 2;
+  table.find(1);
+  table.erase(table.find(2));
+
+  ASSERT_TRUE(table.is_small());
+  ASSERT_EQ(small_stats[inst::operation::insert].count(), 2U);
+  ASSERT_EQ(small_stats[inst::operation::find].count(), 2U);
+  ASSERT_EQ(small_stats[inst::operation::erase].count(), 1U);
+}
+#endif
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
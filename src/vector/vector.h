@@ -3,25 +3,34 @@
 #include <initializer_list>
 #include <limits>
 
+#include "instrument.h"
+#include "vector_allocator.h"
 #include "vector_iterator.h"
+#include "vector_parallel.h"
 
 namespace containers {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Vector {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
   using size_type = size_t;
   using iterator = VectorIterator<T>;
   using const_iterator = ConstVectorIterator<T>;
 
   Vector() = default;
   explicit Vector(size_type capacity, const_reference value = {});
+  Vector(size_type capacity, const_reference value,
+         const parallel_policy& policy);
   Vector(std::initializer_list<T> const& items);
-  Vector(const Vector<T>& v);
-  Vector(Vector<T>&& v) noexcept;
+  Vector(const Vector& v);
+  Vector(const Vector& v, const parallel_policy& policy);
+  Vector(Vector&& v) noexcept;
   ~Vector() = default;
 
   Vector& operator=(Vector&& v) noexcept;
@@ -30,6 +39,9 @@ class Vector {
 
   const_reference front() const;
   const_reference back() const;
+  pointer data() noexcept;
+  const_pointer data() const noexcept;
+  allocator_type get_allocator() const noexcept;
 
   iterator begin();
   iterator end();
@@ -50,6 +62,8 @@ class Vector {
   void set_element(size_type pos, const_reference value);
   void push_back(const_reference value);
   void clear();
+  void fill(const_reference value);
+  void fill(const_reference value, const parallel_policy& policy);
 
   iterator insert(iterator pos, const_reference value);
   template <typename... Args>
@@ -59,55 +73,109 @@ class Vector {
 
   void erase(iterator pos);
   void pop_back();
-  void swap(Vector<T>& other);
+  void swap(Vector& other);
 
  protected:
   void allocate_vector(size_type size);
+  std::shared_ptr<T[]> make_buffer(size_type size);
 
  private:
+  using traits = std::allocator_traits<Allocator>;
+
+  struct deleter {
+    Allocator allocator;
+    size_type size;
+
+    void operator()(T* ptr) noexcept {
+      std::destroy_n(ptr, size);
+      traits::deallocate(allocator, ptr, size);
+    }
+  };
+
   std::shared_ptr<T[]> data_;
   size_type size_{0};
   size_type capacity_{0};
+  Allocator allocator_{};
 };
 
 template <typename T>
-void Vector<T>::allocate_vector(size_type size) {
+using aligned_vector = Vector<T, aligned_allocator<T>>;
+
+template <typename T>
+using huge_page_vector = Vector<T, huge_page_allocator<T>>;
+
+template <typename T, typename Allocator>
+std::shared_ptr<T[]> Vector<T, Allocator>::make_buffer(size_type size) {
+  T* ptr = nullptr;
   try {
-    data_.reset(new T[size]);
+    ptr = traits::allocate(allocator_, size);
   } catch (std::bad_alloc& e) {
     throw std::runtime_error("Error: Failed to allocate memory");
   }
+
+  try {
+    std::uninitialized_default_construct_n(ptr, size);
+  } catch (...) {
+    traits::deallocate(allocator_, ptr, size);
+    throw;
+  }
+
+  return std::shared_ptr<T[]>(ptr, deleter{allocator_, size});
 }
 
-template <typename T>
-Vector<T>::Vector(size_type capacity, const_reference value)
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::allocate_vector(size_type size) {
+  data_ = make_buffer(size);
+}
+
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(size_type capacity, const_reference value)
     : size_(capacity), capacity_(capacity) {
   allocate_vector(capacity_);
-  std::uninitialized_fill_n(data_.get(), capacity_, value);
+  std::fill_n(data_.get(), capacity_, value);
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> const& items)
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(size_type capacity, const_reference value,
+                             const parallel_policy& policy)
+    : size_(capacity), capacity_(capacity) {
+  allocate_vector(capacity_);
+  parallel_fill_n(data_.get(), capacity_, value, policy);
+}
+
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(std::initializer_list<T> const& items)
     : size_(items.size()), capacity_(items.size()) {
   allocate_vector(size_);
   std::copy(items.begin(), items.end(), data_.get());
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector<T>& v) : size_(v.size()), capacity_(v.size()) {
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const Vector& v)
+    : size_(v.size()), capacity_(v.size()), allocator_(v.allocator_) {
   allocate_vector(size_);
   std::copy(v.begin(), v.end(), data_.get());
 }
 
-template <typename T>
-Vector<T>::Vector(Vector<T>&& v) noexcept
-    : data_(std::move(v.data_)), size_(v.size()), capacity_(v.size()) {
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const Vector& v, const parallel_policy& policy)
+    : size_(v.size()), capacity_(v.size()), allocator_(v.allocator_) {
+  allocate_vector(size_);
+  parallel_copy_n(v.data_.get(), size_, data_.get(), policy);
+}
+
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(Vector&& v) noexcept
+    : data_(std::move(v.data_)),
+      size_(v.size()),
+      capacity_(v.size()),
+      allocator_(v.allocator_) {
   v.size_ = 0;
   v.capacity_ = 0;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector&& v) noexcept {
+template <typename T, typename Allocator>
+Vector<T, Allocator>& Vector<T, Allocator>::operator=(Vector&& v) noexcept {
   size_ = v.size();
   capacity_ = v.capacity();
   allocate_vector(size_);
@@ -116,64 +184,89 @@ Vector<T>& Vector<T>::operator=(Vector&& v) noexcept {
   return *this;
 }
 
-template <typename T>
-bool Vector<T>::empty() const noexcept {
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::empty() const noexcept {
   return size_ == 0;
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::size() const noexcept {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::size()
+    const noexcept {
   return size_;
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::max_size() const noexcept {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::max_size()
+    const noexcept {
   return std::numeric_limits<size_type>::max();
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::capacity() const noexcept {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::capacity()
+    const noexcept {
   return capacity_;
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::begin() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::pointer Vector<T, Allocator>::data() noexcept {
+  return data_.get();
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_pointer Vector<T, Allocator>::data()
+    const noexcept {
+  return data_.get();
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::allocator_type
+Vector<T, Allocator>::get_allocator() const noexcept {
+  return allocator_;
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::begin() {
   return iterator(data_, size_);
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::end() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::end() {
   iterator b = begin();
   return b + size_;
 }
 
-template <typename T>
-typename Vector<T>::const_iterator Vector<T>::begin() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_iterator Vector<T, Allocator>::begin()
+    const {
   return const_iterator(data_, size_);
 }
 
-template <typename T>
-typename Vector<T>::const_iterator Vector<T>::end() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_iterator Vector<T, Allocator>::end()
+    const {
   const_iterator b = begin();
   return b + size_;
 }
 
-template <typename T>
-typename Vector<T>::const_iterator Vector<T>::cbegin() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_iterator Vector<T, Allocator>::cbegin()
+    const {
   return const_iterator(data_, size_);
 }
 
-template <typename T>
-typename Vector<T>::const_iterator Vector<T>::cend() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_iterator Vector<T, Allocator>::cend()
+    const {
   const_iterator b = cbegin();
   return b + size_;
 }
 
-template <typename T>
-void Vector<T>::reserve(size_type new_cap) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::reserve(size_type new_cap) {
   if (!new_cap) new_cap = 2;
 
   if (new_cap > capacity()) {
+    CONTAINERS_MEASURE(growth);
     auto tmp{*this};
     capacity_ = new_cap;
     allocate_vector(capacity_);
@@ -181,8 +274,9 @@ void Vector<T>::reserve(size_type new_cap) {
   }
 }
 
-template <typename T>
-typename Vector<T>::reference Vector<T>::at(const size_type pos) {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::reference Vector<T, Allocator>::at(
+    const size_type pos) {
   if (pos >= size_) {
     throw std::out_of_range("Error: Attempt to access beyond the vector");
   }
@@ -191,8 +285,9 @@ typename Vector<T>::reference Vector<T>::at(const size_type pos) {
   return *it;
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::at(const size_type pos) const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::at(
+    const size_type pos) const {
   if (pos >= size_) {
     throw std::out_of_range("Error: Attempt to access beyond the vector");
   }
@@ -201,59 +296,75 @@ typename Vector<T>::const_reference Vector<T>::at(const size_type pos) const {
   return *it;
 }
 
-template <typename T>
-typename Vector<T>::reference Vector<T>::operator[](size_type pos) {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::reference Vector<T, Allocator>::operator[](
+    size_type pos) {
   return at(pos);
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::operator[](size_type pos) const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference
+Vector<T, Allocator>::operator[](size_type pos) const {
   return at(pos);
 }
 
-template <typename T>
-void Vector<T>::set_element(size_type pos, const_reference value) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::set_element(size_type pos, const_reference value) {
   this->at(pos) = value;
 }
 
-template <typename T>
-void Vector<T>::push_back(const_reference value) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::push_back(const_reference value) {
   insert_many_back(value);
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::front() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::front()
+    const {
   return at(0);
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::back() const {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::back()
+    const {
   return at(size_ - 1);
 }
 
-template <typename T>
-void Vector<T>::shrink_to_fit() {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::shrink_to_fit() {
   if (size_ < capacity_) {
     capacity_ = size_;
-    std::shared_ptr<T[]> tmp(new T[capacity_]);
+    std::shared_ptr<T[]> tmp = make_buffer(capacity_);
     std::copy(data_.get(), data_.get() + size_, tmp.get());
     data_ = std::move(tmp);
   }
 }
 
-template <typename T>
-void Vector<T>::clear() {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::clear() {
   size_ = 0;
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::insert(iterator pos,
-                                               const_reference value) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::fill(const_reference value) {
+  std::fill_n(data_.get(), size_, value);
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::fill(const_reference value,
+                                const parallel_policy& policy) {
+  parallel_fill_n(data_.get(), size_, value, policy);
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(
+    iterator pos, const_reference value) {
   return insert_many(pos, value);
 }
 
-template <typename T>
-void Vector<T>::erase(iterator pos) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::erase(iterator pos) {
+  CONTAINERS_MEASURE(erase);
   size_t posIndex = std::distance(begin(), pos);
   auto it = begin();
   for (size_t i = posIndex; i < size() - 1; ++i) {
@@ -262,30 +373,33 @@ void Vector<T>::erase(iterator pos) {
   --size_;
 }
 
-template <typename T>
-void Vector<T>::pop_back() {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::pop_back() {
+  CONTAINERS_MEASURE(pop);
   if (size_ > 0) {
     --size_;
   }
 }
 
-template <typename T>
-void Vector<T>::swap(Vector<T>& other) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::swap(Vector& other) {
   std::swap(data_, other.data_);
   std::swap(size_, other.size_);
   std::swap(capacity_, other.capacity_);
+  std::swap(allocator_, other.allocator_);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename... Args>
-typename Vector<T>::iterator Vector<T>::insert_many(iterator pos,
-                                                    Args&&... args) {
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert_many(
+    iterator pos, Args&&... args) {
+  CONTAINERS_MEASURE(insert);
   size_t posIndex = std::distance(begin(), pos);
   size_t numArgs = sizeof...(args);
 
   if (size() + numArgs > capacity()) {
-    reserve(size() + numArgs); 
-    pos = begin() + posIndex;  
+    reserve(size() + numArgs);
+    pos = begin() + posIndex;
   }
 
   auto it = begin() + posIndex;
@@ -300,9 +414,10 @@ typename Vector<T>::iterator Vector<T>::insert_many(iterator pos,
   return pos;
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename... Args>
-void Vector<T>::insert_many_back(Args&&... args) {
+void Vector<T, Allocator>::insert_many_back(Args&&... args) {
+  CONTAINERS_MEASURE(push);
   if (size() == capacity()) {
     reserve(capacity() * 2);
   }
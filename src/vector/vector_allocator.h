@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace containers {
+
+constexpr size_t cache_line_size = 64;
+constexpr size_t huge_page_size = size_t{2} << 20;
+
+template <typename T, size_t Alignment = cache_line_size>
+class aligned_allocator {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+
+ public:
+  using value_type = T;
+  static constexpr size_t alignment =
+      Alignment < alignof(T) ? alignof(T) : Alignment;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  }
+  void deallocate(T* p, size_t) noexcept {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+
+  friend bool operator==(const aligned_allocator&,
+                         const aligned_allocator&) noexcept {
+    return true;
+  }
+  friend bool operator!=(const aligned_allocator&,
+                         const aligned_allocator&) noexcept {
+    return false;
+  }
+};
+
+// Buffers of at least Threshold bytes are mapped directly, aligned to the
+// huge page size and advised with MADV_HUGEPAGE. When transparent huge pages
+// are disabled the advice is ignored and the mapping stays on regular pages.
+template <typename T, size_t Alignment = cache_line_size,
+          size_t Threshold = huge_page_size>
+class huge_page_allocator {
+ public:
+  using value_type = T;
+  static constexpr size_t alignment = aligned_allocator<T, Alignment>::alignment;
+  static constexpr size_t threshold = Threshold;
+
+  template <typename U>
+  struct rebind {
+    using other = huge_page_allocator<U, Alignment, Threshold>;
+  };
+
+  huge_page_allocator() noexcept = default;
+  template <typename U>
+  huge_page_allocator(
+      const huge_page_allocator<U, Alignment, Threshold>&) noexcept {}
+
+  T* allocate(size_t n) {
+    size_t bytes = n * sizeof(T);
+    if (!use_mapping(bytes)) {
+      return aligned_allocator<T, Alignment>().allocate(n);
+    }
+    return static_cast<T*>(map_huge(mapping_size(bytes)));
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    size_t bytes = n * sizeof(T);
+    if (!use_mapping(bytes)) {
+      aligned_allocator<T, Alignment>().deallocate(p, n);
+      return;
+    }
+    unmap(p, mapping_size(bytes));
+  }
+
+  friend bool operator==(const huge_page_allocator&,
+                         const huge_page_allocator&) noexcept {
+    return true;
+  }
+  friend bool operator!=(const huge_page_allocator&,
+                         const huge_page_allocator&) noexcept {
+    return false;
+  }
+
+ private:
+  static bool use_mapping(size_t bytes) noexcept {
+#if defined(__linux__)
+    return bytes >= Threshold && alignment <= huge_page_size;
+#else
+    (void)bytes;
+    return false;
+#endif
+  }
+
+  static size_t mapping_size(size_t bytes) noexcept {
+    return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+  }
+
+  static void* map_huge(size_t size) {
+#if defined(__linux__)
+    size_t padded = size + huge_page_size;
+    void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    auto begin = reinterpret_cast<uintptr_t>(raw);
+    auto aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (aligned > begin) {
+      ::munmap(raw, aligned - begin);
+    }
+    size_t tail = begin + padded - (aligned + size);
+    if (tail) {
+      ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+
+    void* ptr = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+#else
+    (void)size;
+    throw std::bad_alloc();
+#endif
+  }
+
+  static void unmap(void* ptr, size_t size) noexcept {
+#if defined(__linux__)
+    ::munmap(ptr, size);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+  }
+};
+
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace containers {
+
+struct parallel_policy {
+  static constexpr size_t default_threshold = size_t{64} << 20;
+
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t threshold = default_threshold;
+  bool streaming = true;
+};
+
+namespace parallel {
+
+constexpr size_t page_size = 4096;
+constexpr size_t stream_width = 16;
+
+inline void stream_fill_bytes(unsigned char* dst, size_t bytes,
+                              const unsigned char* pattern) {
+#if defined(__SSE2__)
+  size_t misalign = reinterpret_cast<uintptr_t>(dst) % stream_width;
+  size_t head = std::min(bytes, (stream_width - misalign) % stream_width);
+  std::memcpy(dst, pattern, head);
+
+  alignas(stream_width) unsigned char rotated[stream_width];
+  for (size_t i = 0; i < stream_width; ++i) {
+    rotated[i] = pattern[(head + i) % stream_width];
+  }
+  __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(rotated));
+
+  unsigned char* it = dst + head;
+  unsigned char* last = dst + bytes;
+  for (; it + stream_width <= last; it += stream_width) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(it), block);
+  }
+  std::memcpy(it, rotated, last - it);
+  _mm_sfence();
+#else
+  for (size_t i = 0; i < bytes; ++i) {
+    dst[i] = pattern[i % stream_width];
+  }
+#endif
+}
+
+inline void stream_copy_bytes(unsigned char* dst, const unsigned char* src,
+                              size_t bytes) {
+#if defined(__SSE2__)
+  size_t misalign = reinterpret_cast<uintptr_t>(dst) % stream_width;
+  size_t head = std::min(bytes, (stream_width - misalign) % stream_width);
+  std::memcpy(dst, src, head);
+
+  size_t i = head;
+  for (; i + stream_width <= bytes; i += stream_width) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), block);
+  }
+  std::memcpy(dst + i, src + i, bytes - i);
+  _mm_sfence();
+#else
+  std::memcpy(dst, src, bytes);
+#endif
+}
+
+template <typename T>
+constexpr bool streamable_v =
+    std::is_trivially_copyable_v<T> && stream_width % sizeof(T) == 0;
+
+template <typename T>
+void fill_chunk(T* dst, size_t n, const T& value, bool streaming) {
+  if constexpr (streamable_v<T>) {
+    if (streaming) {
+      unsigned char pattern[stream_width];
+      for (size_t i = 0; i < stream_width; i += sizeof(T)) {
+        std::memcpy(pattern + i, &value, sizeof(T));
+      }
+      stream_fill_bytes(reinterpret_cast<unsigned char*>(dst), n * sizeof(T),
+                        pattern);
+      return;
+    }
+  }
+  std::fill_n(dst, n, value);
+}
+
+template <typename T>
+void copy_chunk(const T* src, size_t n, T* dst, bool streaming) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (streaming) {
+      stream_copy_bytes(reinterpret_cast<unsigned char*>(dst),
+                        reinterpret_cast<const unsigned char*>(src),
+                        n * sizeof(T));
+      return;
+    }
+  }
+  std::copy_n(src, n, dst);
+}
+
+// Splits [0, n) into one chunk per thread. Inner boundaries are moved up
+// to the next page boundary of the actual addresses behind base, so no
+// page is first-touched by two threads.
+template <typename T, typename Function>
+void for_each_chunk(const T* base, size_t n, const parallel_policy& policy,
+                    Function f) {
+  size_t threads = std::max<size_t>(1, policy.threads);
+  uintptr_t origin = reinterpret_cast<uintptr_t>(base);
+
+  std::vector<size_t> bounds{0};
+  for (size_t i = 1; i < threads; ++i) {
+    uintptr_t target = origin + n / threads * i * sizeof(T);
+    uintptr_t page = (target + page_size - 1) / page_size * page_size;
+    size_t bound = std::min(n, (page - origin + sizeof(T) - 1) / sizeof(T));
+    if (bound > bounds.back() && bound < n) bounds.push_back(bound);
+  }
+  bounds.push_back(n);
+
+  std::vector<std::thread> workers;
+  try {
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+      workers.emplace_back(f, bounds[i], bounds[i + 1] - bounds[i]);
+    }
+  } catch (...) {
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    throw;
+  }
+  f(0, bounds[1]);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+template <typename T>
+bool is_parallel(size_t n, const parallel_policy& policy) {
+  return std::is_trivially_copyable_v<T> && policy.threads > 1 &&
+         n * sizeof(T) >= policy.threshold;
+}
+
+}  // namespace parallel
+
+template <typename T>
+void parallel_fill_n(T* dst, size_t n, const T& value,
+                     const parallel_policy& policy) {
+  if (n * sizeof(T) < policy.threshold) {
+    std::fill_n(dst, n, value);
+  } else if (!parallel::is_parallel<T>(n, policy)) {
+    parallel::fill_chunk(dst, n, value, policy.streaming);
+  } else {
+    parallel::for_each_chunk(dst, n, policy, [&](size_t begin, size_t count) {
+      parallel::fill_chunk(dst + begin, count, value, policy.streaming);
+    });
+  }
+}
+
+template <typename T>
+void parallel_copy_n(const T* src, size_t n, T* dst,
+                     const parallel_policy& policy) {
+  if (n * sizeof(T) < policy.threshold) {
+    std::copy_n(src, n, dst);
+  } else if (!parallel::is_parallel<T>(n, policy)) {
+    parallel::copy_chunk(src, n, dst, policy.streaming);
+  } else {
+    parallel::for_each_chunk(dst, n, policy, [&](size_t begin, size_t count) {
+      parallel::copy_chunk(src + begin, count, dst + begin, policy.streaming);
+    });
+  }
+}
+
+}